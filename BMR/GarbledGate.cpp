@@ -40,6 +40,7 @@ void GarbledGate::compute_prfs_outputs(const Register** in_wires, int my_id,
 {
     int n_parties = CommonParty::get_n_parties();
     init_inputs(g, n_parties);
+    vector<int128> outputs(n_parties);
     for(int w=0; w<=1; w++) {
         for (int b=0; b<=1; b++) {
             const Key& key = in_wires[w]->key(my_id, b);
@@ -49,9 +50,10 @@ void GarbledGate::compute_prfs_outputs(const Register** in_wires, int my_id,
             cout << "using key " << key << endl;
 #endif
             for (int e=0; e<=1; e++) {
+                PRF_blocks(rd_key, (__m128i*)input(e, 1),
+                        (__m128i*) outputs.data(), n_parties);
                 for (int j=1; j<= n_parties; j++) {
-                    prf_output[j-1].outputs[w][b][e][0] =
-                            aes_128_encrypt(*(__m128i*)input(e, j), (octet*)rd_key);
+                    prf_output[j-1].outputs[w][b][e][0] = outputs[j-1].a;
                 }
             }
         }
@@ -43,6 +43,15 @@ public:
 	static void convcbit(Integer& dest, const GC::Clear& source,
 	        GC::Processor<GC::Secret<RealGarbleWire>>& processor);
 
+	static void ands(GC::Processor<GC::Secret<RealGarbleWire>>& processor,
+			const vector<int>& args)
+	{ and_(processor, args, false); }
+	static void andrs(GC::Processor<GC::Secret<RealGarbleWire>>& processor,
+			const vector<int>& args)
+	{ and_(processor, args, true); }
+	static void and_(GC::Processor<GC::Secret<RealGarbleWire>>& processor,
+			const vector<int>& args, bool repeat);
+
 	static void inputb(GC::Processor<GC::Secret<RealGarbleWire>>& processor,
 			const vector<int>& args);
 	static void inputbvec(GC::Processor<GC::Secret<RealGarbleWire>>& processor,
@@ -30,6 +30,52 @@ void RealGarbleWire<T>::garble(PRFOutputs& prf_output,
 	party.garble_jobs.push_back(job);
 }
 
+/**
+ * Garble all AND gates of one instruction at once, reusing the PRF buffers
+ * and reserving the jobs for the batched multiplications and openings
+ */
+template<class T>
+void RealGarbleWire<T>::and_(
+		GC::Processor<GC::Secret<RealGarbleWire>>& processor,
+		const vector<int>& args, bool repeat)
+{
+	auto& party = RealProgramParty<T>::s();
+	int n = party.N.num_players();
+	int dl = GC::Secret<RealGarbleWire>::default_length;
+	processor.check_args(args, 4);
+
+	size_t n_gates = 0;
+	for (size_t i = 0; i < args.size(); i += 4)
+		n_gates += args[i];
+	party.garble_jobs.reserve(party.garble_jobs.size() + n_gates);
+
+	GarbledGate gate(n);
+	PRFOutputs prf_output(n);
+	for (size_t i = 0; i < args.size(); i += 4)
+	{
+		for (int j = 0; j < DIV_CEIL(args[i], dl); j++)
+		{
+			int n_bits = min(dl, args[i] - j * dl);
+			auto& out = processor.S[args[i + 1] + j];
+			auto& left = processor.S[args[i + 2] + j];
+			auto& right = processor.S[args[i + 3] + (repeat ? 0 : j)];
+			out.resize_regs(n_bits);
+			for (int k = 0; k < n_bits; k++)
+			{
+				auto& l = left.get_reg(k);
+				auto& r = right.get_reg(repeat ? 0 : k);
+				const Register* in_wires[2] = { &l, &r };
+				// same order as PRFRegister::op()
+				party.receive_keys(out.get_reg(k));
+				gate.compute_prfs_outputs(in_wires, party.get_id(),
+						prf_output, party.new_gate());
+				out.get_reg(k).garble(prf_output, l, r);
+			}
+		}
+		processor.complexity += args[i];
+	}
+}
+
 template<class T>
 GarbleJob<T>::GarbleJob(T lambda_u, T lambda_v, T lambda_w) :
 		lambda_u(lambda_u), lambda_v(lambda_v), lambda_w(lambda_w)
@@ -231,14 +277,9 @@ void RealGarbleWire<T>::output()
 {
 	PRFRegister::output();
 	auto& party = RealProgramParty<T>::s();
-	assert(party.MC != 0);
-	assert(party.P != 0);
-	auto m = party.MC->open(mask, *party.P);
-	party.garble_output_masks.push_back(m.get_bit(0));
+	// opened together with the garbled tables
+	party.output_mask_shares.push_back(mask);
 	party.taint();
-#ifdef DEBUG_MASK
-	cout << "output mask: " << m << endl;
-#endif
 }
 
 template<class T>
@@ -38,6 +38,7 @@ class RealProgramParty : public ProgramPartySpec<T>
 	Inputter* garble_inputter;
 	typename T::Protocol* garble_protocol;
 	vector<GarbleJob<T>> garble_jobs;
+	vector<T> output_mask_shares;
 
 	GC::BreakType next;
 
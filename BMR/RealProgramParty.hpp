@@ -194,12 +194,25 @@ void RealProgramParty<T>::garble()
 		for (auto& job : garble_jobs)
 			job.last_round(*this, *garble_inputter, second_protocol, wires);
 
+		// open garbled tables and output masks in one round
+		size_t n_entries = wires.size();
+		wires.insert(wires.end(), output_mask_shares.begin(),
+				output_mask_shares.end());
+		output_mask_shares.clear();
+
 		vector<typename T::clear> opened;
 		MC->POpen(opened, wires, *P);
 
 		LocalBuffer garbled_circuit;
-		for (auto& x : opened)
-			garbled_circuit.serialize(x);
+		for (size_t i = 0; i < n_entries; i++)
+			garbled_circuit.serialize(opened[i]);
+		for (size_t i = n_entries; i < opened.size(); i++)
+		{
+#ifdef DEBUG_MASK
+			cout << "output mask: " << opened[i] << endl;
+#endif
+			garble_output_masks.push_back(opened[i].get_bit(0));
+		}
 
 		this->garbled_circuits.push_and_clear(garbled_circuit);
 		this->input_masks_store.push_and_clear(garble_input_masks);
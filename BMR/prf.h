@@ -10,25 +10,26 @@
 
 #include "Tools/aes.h"
 
+inline void PRF_blocks(const __m128i* rd_key, const __m128i* in, __m128i* out,
+		int number)
+{
+	// pipelined AES on up to eight blocks at a time
+	int i = 0;
+	for (; i + 8 <= number; i += 8)
+		ecb_aes_128_encrypt<8>(out + i, in + i, (octet*)rd_key);
+	for (; i + 4 <= number; i += 4)
+		ecb_aes_128_encrypt<4>(out + i, in + i, (octet*)rd_key);
+	for (; i + 2 <= number; i += 2)
+		ecb_aes_128_encrypt<2>(out + i, in + i, (octet*)rd_key);
+	for (; i < number; i++)
+		ecb_aes_128_encrypt<1>(out + i, in + i, (octet*)rd_key);
+}
+
 inline void PRF_chunk(const Key& key, char* input, char* output, int number)
 {
-	__m128i* in = (__m128i*)input;
-	__m128i* out = (__m128i*)output;
 	__m128i rd_key[15];
 	aes_128_schedule((octet*) rd_key, (unsigned char*)&key.r);
-	switch (number)
-	{
-	case 2:
-		ecb_aes_128_encrypt<2>(out, in, (octet*)rd_key);
-		break;
-	case 3:
-		ecb_aes_128_encrypt<3>(out, in, (octet*)rd_key);
-		break;
-	default:
-		for (int i = 0; i < number; i++)
-			ecb_aes_128_encrypt<1>(&out[i], &in[i], (octet*)rd_key);
-		break;
-	}
+	PRF_blocks(rd_key, (__m128i*)input, (__m128i*)output, number);
 }
 
 #endif /* PROTOCOL_INC_PRF_H_ */
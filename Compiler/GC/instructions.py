@@ -54,6 +54,7 @@ opcodes = dict(
     SPLIT = 0x248,
     CONVCBIT2S = 0x249,
     ANDRSVEC = 0x24a,
+    CIRCUIT = 0x24b,
     XORCBI = 0x210,
     BITDECC = 0x211,
     NOTCB = 0x212,
@@ -225,6 +226,48 @@ class ands(BinaryVectorInstruction):
     def add_usage(self, req_node):
         req_node.increment(('bit', 'triple'), sum(self.args[::4]))
 
+class circuit(base.VarArgsInstruction, base.DynFormatInstruction):
+    """ Evaluate a circuit in Bristol Fashion from
+    ``Programs/Circuits/<name>.txt`` in parallel.
+
+    :param: number of arguments to follow (int)
+    :param: circuit name (string)
+    :param: number of parallel evaluations (int)
+    :param: number of output wires (int)
+    :param: output wire (sbit)
+    :param: (repeat output wire)...
+    :param: input wire (sbit)
+    :param: (repeat input wire)...
+    """
+    code = opcodes['CIRCUIT']
+    n_ands = {}
+
+    @classmethod
+    def dynamic_arg_format(cls, args):
+        yield 'varstr'
+        next(args)
+        yield 'int'
+        next(args)
+        yield 'int'
+        n = next(args)
+        for i in range(n):
+            yield 'sbw'
+            next(args)
+        while True:
+            try:
+                yield 'sb'
+                next(args)
+            except StopIteration:
+                break
+
+    def add_usage(self, req_node):
+        name = self.args[0]
+        if name not in self.n_ands:
+            with open('Programs/Circuits/%s.txt' % name) as f:
+                self.n_ands[name] = sum(line.rstrip().endswith('AND')
+                                        for line in f)
+        req_node.increment(('bit', 'triple'), self.args[1] * self.n_ands[name])
+
 class andm(BinaryVectorInstruction):
     """ Bitwise AND of single secret and clear bit registers.
 
@@ -11,6 +11,7 @@ the ones used below into ``Programs/Circuits`` as follows::
 import math
 
 from Compiler.GC.types import *
+from Compiler.GC import instructions as inst
 from Compiler.library import function_block, get_tape
 from Compiler import util
 import itertools
@@ -44,22 +45,34 @@ class Circuit:
     last result, which should be ``0x3ad77bb40d7a3660a89ecaf32466ef97``,
     one of the test vectors for AES-128.
 
+    With ``native=True``, the circuit is not compiled into
+    instructions per gate. Instead, the virtual machine loads the
+    circuit at run time, caches it in layers of independent gates, and
+    evaluates it with one instruction per layer. This reduces the
+    compilation time for large circuits such as AES. The circuit file
+    has to be present in ``Programs/Circuits`` for all parties.
+
     """
 
-    def __init__(self, name):
+    def __init__(self, name, native=False):
+        self.name = name
         self.filename = 'Programs/Circuits/%s.txt' % name
         f = open(self.filename)
         self.functions = {}
+        self.native = native
 
     def __call__(self, *inputs):
         return self.run(*inputs)
 
     def run(self, *inputs):
         n = inputs[0][0].n, get_tape()
-        if n not in self.functions:
-            self.functions[n] = function_block(lambda *args:
-                                               self.compile(*args))
-        flat_res = self.functions[n](*itertools.chain(*inputs))
+        if self.native:
+            flat_res = self.run_native(n[0], itertools.chain(*inputs))
+        else:
+            if n not in self.functions:
+                self.functions[n] = function_block(lambda *args:
+                                                   self.compile(*args))
+            flat_res = self.functions[n](*itertools.chain(*inputs))
         res = []
         i = 0
         for l in self.n_output_wires:
@@ -70,6 +83,17 @@ class Circuit:
             res.append(sbitvec.from_vec(v))
         return util.untuplify(res)
 
+    def run_native(self, n, inputs):
+        with open(self.filename) as f:
+            next(f)
+            next(f)
+            self.n_output_wires = [int(x) for x in next(f).split()[1:]]
+        sbn = sbits.get_type(n)
+        inputs = [sbn.conv(x) for x in inputs]
+        res = [sbn() for i in range(sum(self.n_output_wires))]
+        inst.circuit(self.name, n, len(res), *(res + inputs))
+        return res
+
     def compile(self, *all_inputs):
         f = open(self.filename)
         lines = iter(f)
@@ -2445,7 +2445,7 @@ class dotprods(base.VarArgsInstruction, base.DataInstruction,
 
     @property
     def gf2n_arg_format(self):
-        return self.arg_format()
+        return self.dynamic_arg_format(iter(self.args))
 
     def get_repeat(self):
         return sum(self.args[i] // 2 - 1
@@ -2642,27 +2642,35 @@ class gensecshuffle(shuffle_base):
     def add_usage(self, req_node):
         self.add_gen_usage(req_node, self.args[1])
 
-class applyshuffle(base.VectorInstruction, shuffle_base):
-    """ Generate secure shuffle to bit used several times.
+class applyshuffle(base.VarArgsInstruction, shuffle_base):
+    """ Apply secure shuffles generated by :py:class:`gensecshuffle`.
+    Instructions in the same round are merged so that the virtual
+    machine can apply all shuffles concurrently.
 
+    :param: number of arguments to follow (multiple of six)
+    :param: vector size (int)
     :param: destination (sint)
     :param: source (sint)
     :param: number of elements to be treated as one (int)
     :param: handle (regint)
     :param: reverse (0/1)
+    :param: (repeat the last six)...
 
     """
     __slots__ = []
     code = base.opcodes['APPLYSHUFFLE']
-    arg_format = ['sw','s','int','ci','int']
+    arg_format = tools.cycle(['int','sw','s','int','ci','int'])
+    is_vec = lambda self: True
 
     def __init__(self, *args, **kwargs):
         super(applyshuffle, self).__init__(*args, **kwargs)
-        assert len(args[0]) == len(args[1])
-        assert len(args[0]) > args[2]
+        for i in range(0, len(args), 6):
+            assert args[i + 1].size == args[i + 2].size == args[i]
+            assert args[i] > args[i + 3]
 
     def add_usage(self, req_node):
-        self.add_apply_usage(req_node, len(self.args[0]), self.args[2])
+        for i in range(0, len(self.args), 6):
+            self.add_apply_usage(req_node, self.args[i], self.args[i + 3])
 
 class delshuffle(base.Instruction):
     """ Delete secure shuffle.
@@ -2692,6 +2700,36 @@ class inverse_permutation(base.VectorInstruction, shuffle_base):
         self.add_gen_usage(req_node, len(self.args[0]))
         self.add_apply_usage(req_node, len(self.args[0]), 1)
 
+class radixsort(shuffle_base):
+    """ Stable radix sort of rows in memory according to bits in
+    memory, using two secure shuffles per bit as in
+    :py:func:`Compiler.sorting.radix_sort_from_matrix`.
+
+    :param: base address of bits (regint, one row of length as
+      number of rows per bit, least significant first)
+    :param: base address of data (regint)
+    :param: number of rows (int)
+    :param: number of bits (int)
+    :param: length of rows (int)
+
+    """
+    __slots__ = []
+    code = base.opcodes['RADIXSORT']
+    arg_format = ['ci','ci','int','int','int']
+
+    def add_usage(self, req_node):
+        n, n_bits, unit_size = self.args[2:]
+        for i in range(n_bits):
+            req_node.increment((self.field_type, 'triple'), n)
+            for j in range(2):
+                self.add_gen_usage(req_node, n)
+            for j in range(3):
+                self.add_apply_usage(req_node, n, 1)
+            if i < n_bits - 1:
+                self.add_apply_usage(req_node, n, 1)
+            else:
+                self.add_apply_usage(req_node, n * unit_size, unit_size)
+
 
 class check(base.Instruction):
     """
@@ -117,6 +117,7 @@ opcodes = dict(
     APPLYSHUFFLE = 0xFC,
     DELSHUFFLE = 0xFD,
     INVPERM = 0xFE,
+    RADIXSORT = 0xFF,
     # Data access
     TRIPLE = 0x50,
     BIT = 0x51,
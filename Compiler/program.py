@@ -155,6 +155,7 @@ class Program(object):
             Compiler.instructions.inputfloat_class,
             Compiler.instructions.inputmixed_class,
             Compiler.instructions.trunc_pr_class,
+            Compiler.instructions.applyshuffle,
             Compiler.instructions_base.Mergeable,
         ]
         import Compiler.GC.instructions as gc
@@ -52,10 +52,28 @@ def radix_sort(k, D, n_bits=None, signed=True):
         bs[-1][:] = bs[-1][:].bit_not()
     radix_sort_from_matrix(bs, D)
 
+def in_arithmetic_memory(A):
+    t = getattr(A.value_type, 'int_type', A.value_type)
+    return isinstance(A, (types.Array, types.SubMultiArray)) and \
+        issubclass(t, types.sint) and A.value_type.mem_size() == 1
+
 def radix_sort_from_matrix(bs, D):
     n = len(D)
     for b in bs:
         assert(len(b) == n)
+    if isinstance(bs, types.SubMultiArray) and len(bs.sizes) == 2 and \
+       in_arithmetic_memory(bs) and in_arithmetic_memory(D):
+        # run all passes in the virtual machine
+        if isinstance(D, types.Array):
+            row_size = 1
+        else:
+            row_size = D.get_part_size()
+        library.break_point()
+        instructions.radixsort(types.regint.conv(bs.address),
+                               types.regint.conv(D.address),
+                               n, len(bs), row_size)
+        library.break_point()
+        return
     B = types.sint.Matrix(n, 2)
     h = types.Array.create_from(types.sint(types.regint.inc(n)))
     @library.for_range(len(bs))
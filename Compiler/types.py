@@ -3031,7 +3031,7 @@ class sint(_secret, _int):
     @read_mem_value
     def secure_permute(self, shuffle, unit_size=1, reverse=False):
         res = sint(size=self.size)
-        applyshuffle(res, self, unit_size, shuffle, reverse)
+        applyshuffle(self.size, res, self, unit_size, shuffle, reverse)
         return res
 
     def inverse_permutation(self):
@@ -7067,10 +7067,17 @@ class SubMultiArray(_vectorizable):
 
         :param permutation: output of :py:func:`sint.get_secure_shuffle()`
         :param reverse: whether to apply inverse (default: False)
+        :param n_threads: permute columns in parallel threads
+          (default: all columns at once in the current thread)
 
         """
-        if n_threads is not None:
-            permutation = MemValue(permutation)
+        if n_threads is None:
+            # rows as units permute all columns in the same round
+            self.assign_vector(self.get_vector().secure_permute(
+                permutation, unit_size=self.get_part_size(),
+                reverse=reverse))
+            return
+        permutation = MemValue(permutation)
         @library.for_range_multithread(n_threads, 1, self.get_part_size())
         def _(i):
             self.set_column(i, self.get_column(i).secure_permute(
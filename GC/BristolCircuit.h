@@ -0,0 +1,189 @@
+/*
+ * BristolCircuit.h
+ *
+ */
+
+#ifndef GC_BRISTOLCIRCUIT_H_
+#define GC_BRISTOLCIRCUIT_H_
+
+#include <vector>
+#include <map>
+#include <string>
+#include <fstream>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <assert.h>
+using namespace std;
+
+#include "Tools/Exceptions.h"
+
+namespace GC
+{
+
+/**
+ * Circuit in Bristol Fashion (``Programs/Circuits/<name>.txt``)
+ * split into layers without dependencies within a layer.
+ * AND gates of the same depth are in one layer.
+ */
+class BristolCircuit
+{
+public:
+    struct Layer
+    {
+        // output and input wires
+        vector<int> xors, ands, invs;
+    };
+
+    int n_wires;
+    vector<int> n_input_wires, n_output_wires;
+    vector<Layer> layers;
+    size_t n_ands;
+
+    static BristolCircuit& get(const string& name);
+
+    BristolCircuit(const string& filename);
+
+    int n_inputs() const
+    {
+        return accumulate(n_input_wires.begin(), n_input_wires.end(), 0);
+    }
+
+    int n_outputs() const
+    {
+        return accumulate(n_output_wires.begin(), n_output_wires.end(), 0);
+    }
+
+    int output_wire(int i) const
+    {
+        return n_wires - n_outputs() + i;
+    }
+};
+
+inline BristolCircuit& BristolCircuit::get(const string& name)
+{
+    static map<string, BristolCircuit> circuits;
+    static mutex lock;
+    lock_guard<mutex> guard(lock);
+    auto it = circuits.find(name);
+    if (it == circuits.end())
+        it = circuits.insert({name,
+                BristolCircuit("Programs/Circuits/" + name + ".txt")}).first;
+    return it->second;
+}
+
+inline BristolCircuit::BristolCircuit(const string& filename) :
+        n_ands(0)
+{
+    ifstream file(filename);
+    if (not file.good())
+        throw file_error(filename);
+
+    int n_gates, n;
+    file >> n_gates >> n_wires;
+    file >> n;
+    n_input_wires.resize(n);
+    for (auto& x : n_input_wires)
+        file >> x;
+    file >> n;
+    n_output_wires.resize(n);
+    for (auto& x : n_output_wires)
+        file >> x;
+
+    // AND depth and number of linear gates on top of it per wire
+    vector<int> and_depth(n_wires, -1), linear_depth(n_wires);
+    for (int i = 0; i < n_inputs(); i++)
+        and_depth[i] = 0;
+
+    struct Gate
+    {
+        string type;
+        int in[2], out;
+    };
+
+    vector<Gate> gates(n_gates);
+    vector<int> max_linear_depth(1);
+    for (auto& gate : gates)
+    {
+        int n_in, n_out;
+        file >> n_in >> n_out;
+        if (n_out != 1 or n_in < 1 or n_in > 2)
+            throw runtime_error("unsupported gate in " + filename);
+        for (int i = 0; i < n_in; i++)
+            file >> gate.in[i];
+        file >> gate.out >> gate.type;
+        if (gate.type == "INV")
+            gate.in[1] = gate.in[0];
+        else if (n_in != 2 or (gate.type != "XOR" and gate.type != "AND"))
+            throw runtime_error(
+                    "unsupported gate " + gate.type + " in " + filename);
+        if (not file.good() or gate.out >= n_wires)
+            throw runtime_error("error reading " + filename);
+
+        int depth = -1;
+        for (int i = 0; i < 2; i++)
+        {
+            assert(gate.in[i] < n_wires);
+            if (and_depth[gate.in[i]] < 0)
+                throw runtime_error("wire used before set in " + filename);
+            depth = max(depth, and_depth[gate.in[i]]);
+        }
+
+        auto& out = gate.out;
+        if (gate.type == "AND")
+        {
+            and_depth[out] = depth + 1;
+            linear_depth[out] = 0;
+            n_ands++;
+        }
+        else
+        {
+            and_depth[out] = depth;
+            linear_depth[out] = 0;
+            for (int i = 0; i < 2; i++)
+                if (and_depth[gate.in[i]] == depth)
+                    linear_depth[out] = max(linear_depth[out],
+                            linear_depth[gate.in[i]] + 1);
+        }
+
+        max_linear_depth.resize(max(max_linear_depth.size(),
+                size_t(and_depth[out] + 1)));
+        max_linear_depth[and_depth[out]] = max(
+                max_linear_depth[and_depth[out]], linear_depth[out]);
+    }
+
+    // linear layers of each AND depth followed by the next AND layer
+    vector<int> offsets;
+    int n_layers = 0;
+    for (auto& x : max_linear_depth)
+    {
+        offsets.push_back(n_layers);
+        n_layers += x + 1;
+    }
+    layers.resize(n_layers);
+
+    for (auto& gate : gates)
+    {
+        auto& out = gate.out;
+        if (gate.type == "AND")
+        {
+            int depth = and_depth[out] - 1;
+            auto& layer = layers.at(offsets[depth] + max_linear_depth[depth]);
+            layer.ands.insert(layer.ands.end(), {out, gate.in[0], gate.in[1]});
+        }
+        else
+        {
+            auto& layer = layers.at(
+                    offsets[and_depth[out]] + linear_depth[out] - 1);
+            if (gate.type == "XOR")
+                layer.xors.insert(layer.xors.end(),
+                        {out, gate.in[0], gate.in[1]});
+            else
+                layer.invs.insert(layer.invs.end(), {out, gate.in[0]});
+        }
+    }
+}
+
+} /* namespace GC */
+
+#endif /* GC_BRISTOLCIRCUIT_H_ */
@@ -65,6 +65,7 @@ enum
     SPLIT = 0x248,
     CONVCBIT2S = 0x249,
     ANDRSVEC = 0x24a,
+    CIRCUIT = 0x24b,
     // write to clear
     CLEAR_WRITE = 0x210,
     XORCBI = 0x210,
@@ -23,6 +23,22 @@ namespace GC
 template <class T>
 class Processor : public ::ProcessorBase, public GC::RuntimeBranching
 {
+    // AND instructions deferred to be merged into one round
+    vector<int> pending_ands, pending_andrs;
+    vector<char> pending_regs;
+    size_t n_pending_ands;
+
+    enum
+    {
+        PENDING_READ = 1,
+        PENDING_WRITE = 2,
+    };
+
+    bool is_pending(int reg, int n, char flags);
+    void mark_pending(int reg, int n, char flags);
+    bool has_pending(const vector<int>& args, int n_args, bool repeat);
+    void add_pending(const vector<int>& args, bool repeat);
+
 public:
     static int check_args(const vector<int>& args, int n);
 
@@ -93,6 +109,10 @@ public:
     void andrs(const vector<int>& args) { and_(args, true); }
     void ands(const vector<int>& args) { and_(args, false); }
     void andrsvec(const vector<int>& args);
+    void circuit(const ::BaseInstruction& instruction);
+
+    bool schedule(const ::BaseInstruction& instruction);
+    void flush_ands();
 
     void input(const vector<int>& args);
     void inputb(typename T::Input& input, ProcessorBase& input_processor,
@@ -13,8 +13,10 @@
 using namespace std;
 
 #include "GC/Program.h"
+#include "GC/BristolCircuit.h"
 #include "Access.h"
 #include "Processor/FixInput.h"
+#include "Processor/OnlineOptions.h"
 #include "Math/BitVec.h"
 
 #include "GC/Machine.hpp"
@@ -33,8 +35,8 @@ Processor<T>::Processor(Machine<T>& machine) :
 
 template <class T>
 Processor<T>::Processor(Memories<T>& memories, Machine<T>* machine) :
-		machine(machine), memories(memories), PC(0), time(0),
-		complexity(0)
+		n_pending_ands(0), machine(machine), memories(memories), PC(0),
+		time(0), complexity(0)
 {
 }
 
@@ -347,6 +349,247 @@ void Processor<T>::andrsvec(const vector<int>& args)
     }
 }
 
+template <class T>
+void Processor<T>::circuit(const ::BaseInstruction& instruction)
+{
+    auto& circuit = BristolCircuit::get(instruction.get_str());
+    auto& args = instruction.get_start();
+    int n_bits = instruction.get_n();
+    int n_outputs = args.at(0);
+    if (n_outputs != circuit.n_outputs()
+            or args.size() != size_t(1 + n_outputs + circuit.n_inputs()))
+        throw runtime_error("wrong number of wires for circuit "
+                + instruction.get_str());
+
+    // each wire holds all parallel evaluations
+    int dl = T::default_length;
+    int unit = DIV_CEIL(n_bits, dl);
+    Memory<T> wires;
+    wires.resize(circuit.n_wires * unit, "circuit wires");
+    for (int i = 0; i < circuit.n_inputs(); i++)
+        for (int j = 0; j < unit; j++)
+            wires[i * unit + j] = S.at(args[1 + n_outputs + i] + j);
+
+    // operate on the wires using the usual instructions
+    S.swap(wires);
+    // restore the registers if the protocol throws
+    try
+    {
+        vector<int> xor_args, and_args;
+        for (auto& layer : circuit.layers)
+        {
+            xor_args.clear();
+            for (size_t i = 0; i < layer.xors.size(); i += 3)
+                xor_args.insert(xor_args.end(), {n_bits, layer.xors[i] * unit,
+                        layer.xors[i + 1] * unit, layer.xors[i + 2] * unit});
+            if (not xor_args.empty())
+                T::xors(*this, xor_args);
+
+            for (size_t i = 0; i < layer.invs.size(); i += 2)
+                for (int j = 0; j < unit; j++)
+                    S[layer.invs[i] * unit + j].invert(
+                            min(dl, n_bits - j * dl),
+                            S[layer.invs[i + 1] * unit + j]);
+
+            and_args.clear();
+            for (size_t i = 0; i < layer.ands.size(); i += 3)
+                and_args.insert(and_args.end(), {n_bits, layer.ands[i] * unit,
+                        layer.ands[i + 1] * unit, layer.ands[i + 2] * unit});
+            if (not and_args.empty())
+                T::ands(*this, and_args);
+        }
+    }
+    catch (...)
+    {
+        S.swap(wires);
+        throw;
+    }
+    S.swap(wires);
+
+    for (int i = 0; i < n_outputs; i++)
+        for (int j = 0; j < unit; j++)
+            S.at(args[1 + i] + j) = wires[circuit.output_wire(i) * unit + j];
+}
+
+/**
+ * Defer AND instructions and merge them with later independent ones
+ * into a single call, so that protocols with interaction per AND call
+ * need fewer rounds. Instructions that only access registers
+ * unrelated to the pending ANDs are executed immediately, and all
+ * others flush the pending ANDs first.
+ *
+ * @returns whether the instruction has been deferred
+ */
+template <class T>
+bool Processor<T>::schedule(const ::BaseInstruction& instruction)
+{
+    if (not OnlineOptions::singleton.merge_ands)
+        return false;
+
+    auto& args = instruction.get_start();
+    int dl = T::default_length;
+    int n = DIV_CEIL(instruction.get_n(), dl);
+    switch (instruction.get_opcode())
+    {
+    case ANDS:
+    case ANDRS:
+    {
+        bool repeat = instruction.get_opcode() == ANDRS;
+        if (has_pending(args, 4, repeat))
+            flush_ands();
+        add_pending(args, repeat);
+        if (n_pending_ands >= size_t(OnlineOptions::singleton.batch_size))
+            flush_ands();
+        return true;
+    }
+    case XORS:
+        if (has_pending(args, 4, false))
+            flush_ands();
+        return false;
+    case NOTS:
+    case MOVSB:
+    case ANDM:
+        if (is_pending(instruction.get_r(0), n, PENDING_READ | PENDING_WRITE)
+                or is_pending(instruction.get_r(1), n, PENDING_WRITE))
+            flush_ands();
+        return false;
+    case LDBITS:
+        if (is_pending(instruction.get_r(0), 1, PENDING_READ | PENDING_WRITE))
+            flush_ands();
+        return false;
+    // no access to secret registers
+    case XORCB:
+    case XORCBI:
+    case NOTCB:
+    case ADDCB:
+    case ADDCBI:
+    case MULCBI:
+    case SHRCBI:
+    case SHLCBI:
+    case BITDECC:
+    case LDMCB:
+    case STMCB:
+    case LDMCBI:
+    case STMCBI:
+    case CONVCINT:
+    case LDINT:
+    case ADDINT:
+    case SUBINT:
+    case MULINT:
+    case DIVINT:
+    case EQZC:
+    case LTZC:
+    case LTC:
+    case GTC:
+    case EQC:
+    case MOVINT:
+    case LDMINT:
+    case STMINT:
+    case LDMINTI:
+    case STMINTI:
+    case PUSHINT:
+    case POPINT:
+    case LDARG:
+    case STARG:
+    case JMP:
+    case JMPNZ:
+    case JMPEQZ:
+    case JMPI:
+        return false;
+    default:
+        flush_ands();
+        return false;
+    }
+}
+
+template <class T>
+void Processor<T>::flush_ands()
+{
+    if (n_pending_ands == 0)
+        return;
+    for (auto args : {&pending_ands, &pending_andrs})
+    {
+        bool repeat = args == &pending_andrs;
+        for (size_t i = 0; i < args->size(); i += 4)
+        {
+            int n = DIV_CEIL((*args)[i], T::default_length);
+            for (int j : {1, 2})
+                mark_pending((*args)[i + j], n, 0);
+            mark_pending((*args)[i + 3], repeat ? 1 : n, 0);
+        }
+    }
+    n_pending_ands = 0;
+    if (not pending_ands.empty())
+        T::ands(*this, pending_ands);
+    if (not pending_andrs.empty())
+        T::andrs(*this, pending_andrs);
+    pending_ands.clear();
+    pending_andrs.clear();
+}
+
+template <class T>
+bool Processor<T>::is_pending(int reg, int n, char flags)
+{
+    if (n_pending_ands == 0)
+        return false;
+    for (int i = reg; i < reg + n; i++)
+        if (pending_regs.at(i) & flags)
+            return true;
+    return false;
+}
+
+template <class T>
+void Processor<T>::mark_pending(int reg, int n, char flags)
+{
+    if (pending_regs.size() < S.size())
+        pending_regs.resize(S.size());
+    for (int i = reg; i < reg + n; i++)
+        if (flags)
+            pending_regs.at(i) |= flags;
+        else
+            pending_regs.at(i) = 0;
+}
+
+/**
+ * Check argument tuples (size, destination, inputs...) against
+ * the pending ANDs
+ */
+template <class T>
+bool Processor<T>::has_pending(const vector<int>& args, int n_args,
+        bool repeat)
+{
+    if (n_pending_ands == 0)
+        return false;
+    check_args(args, n_args);
+    for (size_t i = 0; i < args.size(); i += n_args)
+    {
+        int n = DIV_CEIL(args[i], T::default_length);
+        if (is_pending(args[i + 1], n, PENDING_READ | PENDING_WRITE))
+            return true;
+        for (int j = 2; j < n_args; j++)
+            if (is_pending(args[i + j], (repeat and j == n_args - 1) ? 1 : n,
+                    PENDING_WRITE))
+                return true;
+    }
+    return false;
+}
+
+template <class T>
+void Processor<T>::add_pending(const vector<int>& args, bool repeat)
+{
+    check_args(args, 4);
+    auto& pending = repeat ? pending_andrs : pending_ands;
+    pending.insert(pending.end(), args.begin(), args.end());
+    for (size_t i = 0; i < args.size(); i += 4)
+    {
+        int n = DIV_CEIL(args[i], T::default_length);
+        mark_pending(args[i + 1], n, PENDING_WRITE);
+        mark_pending(args[i + 2], n, PENDING_READ);
+        mark_pending(args[i + 3], repeat ? 1 : n, PENDING_READ);
+        n_pending_ands += args[i];
+    }
+}
+
 template <class T>
 void Processor<T>::input(const vector<int>& args)
 {
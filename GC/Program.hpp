@@ -106,6 +106,7 @@ BreakType Program::execute(Processor<T>& Proc, U& dynamic_memory,
 #endif
         if (Proc.PC >= size)
         {
+            Proc.flush_ands();
             Proc.time = time;
             return DONE_BREAK;
         }
@@ -113,14 +114,15 @@ BreakType Program::execute(Processor<T>& Proc, U& dynamic_memory,
         Proc.stats[p[Proc.PC].get_opcode()]++;
 #endif
         auto& instruction = p[Proc.PC++];
-        switch (instruction.get_opcode())
-        {
+        if (not Proc.schedule(instruction))
+            switch (instruction.get_opcode())
+            {
 #define X(NAME, CODE) case NAME: CODE; break;
-        INSTRUCTIONS
+            INSTRUCTIONS
 #undef X
-        default:
-            fallback_code(instruction, processor);
-        }
+            default:
+                fallback_code(instruction, processor);
+            }
         time++;
 #ifdef DEBUG_COMPLEXITY
         cout << T::part_type::name() << " complexity at " << time << ": " <<
@@ -129,6 +131,7 @@ BreakType Program::execute(Processor<T>& Proc, U& dynamic_memory,
 #endif
     }
     while (Proc.complexity < (size_t) OnlineOptions::singleton.batch_size);
+    Proc.flush_ands();
     Proc.time = time;
 #ifdef DEBUG_ROUNDS
     cout << "breaking at time " << Proc.time << endl;
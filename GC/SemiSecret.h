@@ -35,6 +35,7 @@ public:
     typedef T small_type;
 
     static const bool is_real = true;
+    static const bool plain_xor = true;
 
     static const int default_length = sizeof(BitVec) * 8;
 
@@ -46,6 +46,8 @@ public:
 
     static const bool is_real = true;
     static const bool actual_inputs = true;
+    // XOR of registers is XOR of the underlying memory
+    static const bool plain_xor = false;
 
     static ShareThread<U>& get_party()
     {
@@ -128,6 +130,7 @@ public:
     static const bool needs_ot = false;
     static const bool has_mac = false;
     static const bool randoms_for_opens = false;
+    static const bool plain_xor = true;
 
     static string type_string() { return "replicated secret"; }
     static string phase_name() { return "Replicated computation"; }
@@ -10,6 +10,7 @@
 #include "GC/ShareParty.h"
 #include "BitPrepFiles.h"
 #include "Math/Setup.h"
+#include "Tools/avx_memcpy.h"
 
 #include "Processor/Data_Files.hpp"
 
@@ -145,10 +146,10 @@ void ShareThread<T>::andrsvec(Processor<T>& processor, const vector<int>& args)
         for (int i = 0; i < size; i += N_BITS)
         {
             int n_ops = min(N_BITS, size - i);
+            processor.S.at(base + i / N_BITS).mask(y_ext, n_ops);
             for (int j = 0; j < n_args; j++)
             {
                 processor.S.at(*(it + j) + i / N_BITS).mask(x_ext, n_ops);
-                processor.S.at(base + i / N_BITS).mask(y_ext, n_ops);
                 protocol->prepare_mul(x_ext, y_ext, n_ops);
             }
         }
@@ -177,6 +178,11 @@ template<class T>
 void ShareThread<T>::xors(Processor<T>& processor, const vector<int>& args)
 {
     processor.check_args(args, 4);
+    // no partial overlap between ranges of registers
+    auto separate = [](int a, int b, int n)
+    {
+        return a == b or a + n <= b or b + n <= a;
+    };
     for (size_t i = 0; i < args.size(); i += 4)
     {
         int n_bits = args[i];
@@ -186,12 +192,27 @@ void ShareThread<T>::xors(Processor<T>& processor, const vector<int>& args)
         if (n_bits == 1)
             processor.S[out].xor_(1, processor.S[left], processor.S[right]);
         else
-            for (int j = 0; j < DIV_CEIL(n_bits, T::default_length); j++)
+        {
+            int j = 0;
+            int n_full = n_bits / T::default_length;
+            if (T::plain_xor and n_full > 1 and separate(out, left, n_full)
+                    and separate(out, right, n_full))
+            {
+                // whole registers at once
+                processor.S.check_index(out + n_full - 1);
+                processor.S.check_index(left + n_full - 1);
+                processor.S.check_index(right + n_full - 1);
+                avx_memxor(&processor.S[out], &processor.S[left],
+                        &processor.S[right], n_full * sizeof(T));
+                j = n_full;
+            }
+            for (; j < DIV_CEIL(n_bits, T::default_length); j++)
             {
                 int n = min(T::default_length, n_bits - j * T::default_length);
                 processor.S[out + j].xor_(n, processor.S[left + j],
                         processor.S[right + j]);
             }
+        }
     }
 }
 
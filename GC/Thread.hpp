@@ -33,6 +33,12 @@ Thread<T>::Thread(int thread_num, ThreadMaster<T>& master) :
         N(master.N), P(0),
         thread_num(thread_num)
 {
+}
+
+template<class T>
+void Thread<T>::start()
+{
+    // not in the constructor because run() calls virtual functions
     pthread_create(&thread, 0, run_thread, this);
 }
 
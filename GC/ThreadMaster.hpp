@@ -71,7 +71,10 @@ void ThreadMaster<T>::run()
     machine.reset(machine.progs[0], memory);
 
     for (int i = 0; i < machine.nthreads; i++)
+    {
         threads.push_back(new_thread(i));
+        threads.back()->start();
+    }
     for (auto thread : threads)
         thread->join_tape();
 
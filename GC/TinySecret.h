@@ -53,6 +53,7 @@ public:
     static const bool malicious = T::malicious;
     static const bool expensive_triples = T::expensive_triples;
     static const bool randoms_for_opens = false;
+    static const bool plain_xor = false;
 
     static const int default_length = 64;
 
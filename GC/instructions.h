@@ -46,6 +46,7 @@
     X(NOTCB, processor.notcb(INST)) \
     X(ANDRS, T::andrs(PROC, EXTRA)) \
     X(ANDRSVEC, T::andrsvec(PROC, EXTRA)) \
+    X(CIRCUIT, PROC.circuit(INST)) \
     X(ANDS, T::ands(PROC, EXTRA)) \
     X(ANDM, T::andm(PROC, instruction)) \
     X(ADDCB, C0 = PC1 + PC2) \
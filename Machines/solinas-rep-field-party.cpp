@@ -0,0 +1,14 @@
+/*
+ * solinas-rep-field-party.cpp
+ *
+ */
+
+#include "Math/gfp.hpp"
+#include "Processor/FieldMachine.hpp"
+#include "Machines/Rep.hpp"
+
+int main(int argc, const char** argv)
+{
+    ez::ezOptionParser opt;
+    SolinasFieldMachine<Rep3Share>(argc, argv, opt);
+}
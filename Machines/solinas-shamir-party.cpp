@@ -0,0 +1,17 @@
+/*
+ * solinas-shamir-party.cpp
+ *
+ */
+
+#include "Machines/ShamirMachine.h"
+#include "Protocols/ShamirShare.h"
+
+#include "ShamirMachine.hpp"
+
+int main(int argc, const char** argv)
+{
+    auto& opts = ShamirOptions::singleton;
+    ez::ezOptionParser opt;
+    opts = {opt, argc, argv};
+    SolinasFieldMachine<ShamirShare>(argc, argv, opt, opts.nparties);
+}
@@ -0,0 +1,168 @@
+/*
+ * DotProduct.h
+ *
+ */
+
+#ifndef MATH_DOTPRODUCT_H_
+#define MATH_DOTPRODUCT_H_
+
+#include "Math/gfp.h"
+
+#include <vector>
+using namespace std;
+
+/**
+ * Accumulation of products
+ */
+template<class T, class = void>
+class DotProduct
+{
+    T sum;
+
+public:
+    static const bool LAZY = false;
+
+    template<class U, class V>
+    void add(const U& x, const V& y)
+    {
+        sum += x * y;
+    }
+
+    T get()
+    {
+        T res = sum;
+        sum = {};
+        return res;
+    }
+};
+
+/**
+ * Products in characteristic two are buffered in order to
+ * accumulate them unreduced and reduce only once
+ */
+template<class T>
+class DotProduct<T,
+        decltype((void) T::dot_product((const T*) 0, (const T*) 0, 0))>
+{
+    static const size_t MAX_BUFFERED = 1024;
+
+    vector<T> xs, ys;
+    T sum;
+
+    void flush()
+    {
+        sum += T::dot_product(xs.data(), ys.data(), xs.size());
+        xs.clear();
+        ys.clear();
+    }
+
+public:
+    static const bool LAZY = true;
+
+    void add(const T& x, const T& y)
+    {
+        xs.push_back(x);
+        ys.push_back(y);
+        if (xs.size() >= MAX_BUFFERED)
+            flush();
+    }
+
+    T get()
+    {
+        flush();
+        T res = sum;
+        sum = {};
+        return res;
+    }
+};
+
+/**
+ * Products modulo a prime are accumulated in double width
+ * and only reduced once. The extra limb absorbs the carries of
+ * up to 2^64 products.
+ */
+template<int X, int L>
+class DotProduct<gfp_<X, L>>
+{
+    typedef gfp_<X, L> T;
+
+    mp_limb_t sum[2 * L + 1];
+
+public:
+    static const bool LAZY = true;
+
+    DotProduct()
+    {
+        inline_mpn_zero(sum, 2 * L + 1);
+    }
+
+    void add(const T& x, const T& y)
+    {
+        auto xx = (const mp_limb_t*) x.get_ptr();
+        auto yy = (const mp_limb_t*) y.get_ptr();
+        for (int i = 0; i < L; i++)
+        {
+            mp_limb_t carry = 0;
+            for (int j = 0; j < L; j++)
+            {
+                __uint128_t tmp = __uint128_t(xx[i]) * yy[j] + sum[i + j]
+                        + carry;
+                sum[i + j] = tmp;
+                carry = tmp >> 64;
+            }
+            for (int j = i + L; j <= 2 * L; j++)
+            {
+                sum[j] += carry;
+                carry = sum[j] < carry;
+            }
+        }
+    }
+
+    T get();
+};
+
+template<int X, int L>
+gfp_<X, L> DotProduct<gfp_<X, L>>::get()
+{
+    auto& ZpD = T::get_ZpD();
+    int t = ZpD.get_t();
+    auto p = ZpD.get_prA();
+    mp_limb_t q[2 * L + 1], r[L];
+    inline_mpn_zero(r, L);
+
+    if (ZpD.get_mont())
+    {
+        // Montgomery reduction removes the extra factor R
+        // from the sum of Montgomery representations
+        // and leaves a value below (n + 1) * p for n products
+        mp_limb_t pi = ZpD.get_pi();
+        for (int i = 0; i < t; i++)
+        {
+            mp_limb_t u = sum[i] * pi, carry = 0;
+            for (int j = 0; j < t; j++)
+            {
+                __uint128_t tmp = __uint128_t(u) * p[j] + sum[i + j] + carry;
+                sum[i + j] = tmp;
+                carry = tmp >> 64;
+            }
+            for (int j = i + t; j <= 2 * L; j++)
+            {
+                sum[j] += carry;
+                carry = sum[j] < carry;
+            }
+        }
+        if (sum[2 * t] == 0 and mpn_cmp(sum + t, p, t) < 0)
+            inline_mpn_copyi(r, sum + t, t);
+        else
+            mpn_tdiv_qr(q, r, 0, sum + t, t + 1, p, t);
+    }
+    else
+        mpn_tdiv_qr(q, r, 0, sum, 2 * L + 1, p, t);
+
+    inline_mpn_zero(sum, 2 * L + 1);
+    T res;
+    res.assign(r);
+    return res;
+}
+
+#endif /* MATH_DOTPRODUCT_H_ */
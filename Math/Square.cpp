@@ -11,10 +11,8 @@
 template<>
 void Square<gf2n_short>::to(gf2n_short& result, false_type)
 {
-    int128 sum;
-    for (int i = 0; i < gf2n_short::degree(); i++)
-        sum ^= int128(rows[i].get()) << i;
-    result = sum;
+    result = gf2n_short::dot_product(rows, monomials(),
+            gf2n_short::degree());
 }
 
 template<>
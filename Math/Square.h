@@ -26,6 +26,22 @@ public:
 
     U rows[N_ROWS];
 
+    // x^i in row i, to combine the rows with a single reduction
+    static const U* monomials()
+    {
+        static const vector<U> res = []()
+        {
+            vector<U> res(N_ROWS);
+            for (int i = 0; i < N_ROWS; i++)
+            {
+                auto x = typename U::internal_type(word(1)) << i;
+                res[i].assign(&x);
+            }
+            return res;
+        }();
+        return res.data();
+    }
+
     Square& sub(const Square& other);
     Square& rsub(const Square& other);
     Square& sub(const void* other);
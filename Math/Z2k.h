@@ -118,6 +118,7 @@ public:
 	bool get_bit(int i) const;
 
 	const void* get_ptr() const { return a; }
+	void* get_ptr() { return a; }
 	const mp_limb_t* get() const { return a; }
 
 	void convert_destroy(bigint& a) { *this = a; }
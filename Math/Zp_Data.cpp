@@ -62,6 +62,15 @@ void Zp_Data::init(const bigint& p,bool mont)
   inline_mpn_zero(prA,MAX_MOD_SZ+1);
   mpn_copyi(prA,pr.get_mpz_t()->_mp_d,t);
 
+  // p = 2^k - c with 4c^2 < p allows reduction by two folds
+  solinas_k=0;
+  solinas_c=0;
+  bigint c=(bigint(1)<<pr_bit_length)-pr;
+  if (not montgomery and t<=4 and c<(bigint(1)<<32) and 4*c*c<pr)
+    { solinas_k=pr_bit_length;
+      solinas_c=c.get_ui();
+    }
+
   lock.unlock();
 }
 
@@ -37,6 +37,9 @@ class Zp_Data
   mp_limb_t   prA[MAX_MOD_SZ+1];
   int         t;           // More Montgomery data
   mp_limb_t   overhang;
+  // p = 2^solinas_k - solinas_c for pseudo-Mersenne primes, zero otherwise
+  int         solinas_k;
+  mp_limb_t   solinas_c;
   Lock        lock;
   mutable bigint shanks_y, shanks_q_half;
   mutable int    shanks_r;
@@ -51,6 +54,10 @@ class Zp_Data
   void Mont_Mult_max(mp_limb_t* z, const mp_limb_t* x, const mp_limb_t* y,
       int max_t) const;
 
+  template <int T>
+  void Solinas_Mult_(mp_limb_t* z,const mp_limb_t* x,const mp_limb_t* y) const;
+  void Solinas_Mult(mp_limb_t* z,const mp_limb_t* x,const mp_limb_t* y) const;
+
   public:
 
   bigint       pr;
@@ -63,7 +70,10 @@ class Zp_Data
   void init(const bigint& p,bool mont=true);
   int get_t() const { assert(t > 0); return t; }
   const mp_limb_t* get_prA() const { return prA; }
+  mp_limb_t get_pi() const { return pi; }
   bool get_mont() const { return montgomery; }
+  // fast reduction is used in standard representation only
+  bool is_solinas() const { return solinas_k > 0; }
   mp_limb_t overhang_mask() const;
 
   void pack(octetStream& o) const;
@@ -75,6 +85,8 @@ class Zp_Data
   {
     t = -1;
     overhang = 0;
+    solinas_k = 0;
+    solinas_c = 0;
     shanks_r = 0;
   }
 
@@ -264,4 +276,73 @@ inline void Zp_Data::Mont_Mult_max(mp_limb_t* z, const mp_limb_t* x,
   Mont_Mult(z, x, y);
 }
 
+/*
+ * Multiplication modulo p = 2^k - c in standard representation.
+ * The product is folded twice using 2^k = c mod p, after which
+ * it is below 2^k + c^2 < 2p, leaving a single conditional subtraction.
+ */
+template <int T>
+inline void Zp_Data::Solinas_Mult_(mp_limb_t* z,const mp_limb_t* x,const mp_limb_t* y) const
+{
+  mp_limb_t ans[2*T+1]={},s[T+1],d[T+1];
+  for (int i=0; i<T; i++)
+    { mp_limb_t carry=0;
+      for (int j=0; j<T; j++)
+        { __uint128_t tmp=__uint128_t(x[i])*y[j]+ans[i+j]+carry;
+          ans[i+j]=tmp;
+          carry=tmp>>64;
+        }
+      ans[i+T]=carry;
+    }
+  int q=solinas_k/64, r=solinas_k%64;
+  mp_limb_t top=(mp_limb_t(1)<<r)-1;
+  // ans = hi * 2^k + lo = lo + c * hi
+  mp_limb_t carry=0;
+  for (int i=0; i<T; i++)
+    { mp_limb_t hi=r ? (ans[q+i]>>r)|(ans[q+i+1]<<(64-r)) : ans[q+i];
+      mp_limb_t lo=i<q ? ans[i] : (i==q ? ans[i]&top : 0);
+      __uint128_t tmp=__uint128_t(hi)*solinas_c+lo+carry;
+      s[i]=tmp;
+      carry=tmp>>64;
+    }
+  s[T]=carry;
+  // s < (c + 1) * 2^k, so s >> k <= c
+  mp_limb_t h=r ? (s[q]>>r)|(s[q+1]<<(64-r)) : s[q];
+  for (int i=0; i<=T; i++)
+    { s[i]=i<q ? s[i] : (i==q ? s[i]&top : 0); }
+  carry=h*solinas_c;
+  for (int i=0; i<=T; i++)
+    { s[i]+=carry;
+      carry=s[i]<carry;
+    }
+  mp_limb_t keep=-mpn_sub_fixed_n_borrow<T+1>(d,s,prA);
+  for (int i=0; i<T; i++)
+    { z[i]=(s[i]&keep)|(d[i]&~keep); }
+}
+
+template <>
+inline void Zp_Data::Solinas_Mult_<1>(mp_limb_t* z,const mp_limb_t* x,const mp_limb_t* y) const
+{
+  __uint128_t ans=__uint128_t(*x)*(*y);
+  int k=solinas_k;
+  mp_limb_t top=mp_limb_t(-1)>>(64-k);
+  __uint128_t s=(mp_limb_t(ans)&top)+__uint128_t(mp_limb_t(ans>>k))*solinas_c;
+  s=(mp_limb_t(s)&top)+__uint128_t(mp_limb_t(s>>k))*solinas_c;
+  __uint128_t d=s-*prA;
+  mp_limb_t keep=-mp_limb_t(s<*prA);
+  *z=(mp_limb_t(s)&keep)|(mp_limb_t(d)&~keep);
+}
+
+inline void Zp_Data::Solinas_Mult(mp_limb_t* z,const mp_limb_t* x,const mp_limb_t* y) const
+{
+  switch (t)
+  {
+#define X(L) case L: Solinas_Mult_<L>(z, x, y); break;
+  X(1) X(2) X(3) X(4)
+#undef X
+  default:
+    throw runtime_error("no special reduction for this size");
+  }
+}
+
 #endif
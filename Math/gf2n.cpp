@@ -357,6 +357,55 @@ gf2n_<U>& gf2n_<U>::mul(const gf2n_& x,const gf2n_& y)
   return *this;
 }
 
+template<class U>
+gf2n_<U> gf2n_<U>::dot_product(const gf2n_* x, const gf2n_* y, size_t length)
+{
+  gf2n_ res;
+  for (size_t i = 0; i < length; i++)
+    res += x[i] * y[i];
+  return res;
+}
+
+template<>
+gf2n_<word> gf2n_<word>::dot_product(const gf2n_* x, const gf2n_* y,
+    size_t length)
+{
+  if (n <= 8 or useC)
+    {
+      gf2n_ res;
+      for (size_t i = 0; i < length; i++)
+        res += x[i] * y[i];
+      return res;
+    }
+
+  static_assert(sizeof(gf2n_) == sizeof(word), "unexpected layout");
+  int128 sum;
+  add_mul64(sum.a, (const word*) x, (const word*) y, length);
+  gf2n_ res;
+  res.reduce(sum.get_upper(), sum.get_lower());
+  return res;
+}
+
+template<>
+gf2n_<int128> gf2n_<int128>::dot_product(const gf2n_* x, const gf2n_* y,
+    size_t length)
+{
+  if (n <= 8)
+    {
+      gf2n_ res;
+      for (size_t i = 0; i < length; i++)
+        res += x[i] * y[i];
+      return res;
+    }
+
+  static_assert(sizeof(gf2n_) == sizeof(int128), "unexpected layout");
+  __m128i sum[2] = {};
+  add_mul128(sum, (const __m128i*) x, (const __m128i*) y, length);
+  gf2n_ res;
+  res.reduce(sum[1], sum[0]);
+  return res;
+}
+
 template<class U>
 gf2n_<U> gf2n_<U>::operator*(const Bit& x) const
 {
@@ -96,6 +96,9 @@ protected:
 
   static gf2n_ Mul(gf2n_ a, gf2n_ b) { return a * b; }
 
+  // sum of x[i] * y[i] with a single reduction
+  static gf2n_ dot_product(const gf2n_* x, const gf2n_* y, size_t length);
+
   U get() const { return a; }
 
   const void* get_ptr() const { return &a; }
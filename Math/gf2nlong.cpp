@@ -23,6 +23,122 @@ bool is_ge(__m128i a, __m128i b)
 }
 
 
+void add_mul128(__m128i res[2], const __m128i* a, const __m128i* b, size_t n)
+{
+  if (n >= 4 and cpu_has_vpclmul())
+    add_mul128_vpclmul(res, a, b, n);
+  else
+    add_mul128_generic(res, a, b, n);
+}
+
+void add_mul128_generic(__m128i res[2], const __m128i* a, const __m128i* b,
+    size_t n)
+{
+  for (size_t i = 0; i < n; i++)
+    {
+      __m128i lo, hi;
+      mul128(_mm_loadu_si128(a + i), _mm_loadu_si128(b + i), &lo, &hi);
+      res[0] ^= lo;
+      res[1] ^= hi;
+    }
+}
+
+#ifdef __x86_64__
+// four products per instruction, reduction of the lanes only at the end
+__attribute__((target("avx512f,vpclmulqdq")))
+static void add_mul128_avx512(__m128i res[2], const __m128i* a,
+    const __m128i* b, size_t n)
+{
+  __m512i lo = _mm512_setzero_si512(), mid = lo, hi = lo;
+  size_t i;
+  for (i = 0; i + 4 <= n; i += 4)
+    {
+      __m512i x = _mm512_loadu_si512(a + i);
+      __m512i y = _mm512_loadu_si512(b + i);
+      lo = _mm512_xor_si512(lo, _mm512_clmulepi64_epi128(x, y, 0x00));
+      hi = _mm512_xor_si512(hi, _mm512_clmulepi64_epi128(x, y, 0x11));
+      mid = _mm512_xor_si512(mid, _mm512_clmulepi64_epi128(x, y, 0x01));
+      mid = _mm512_xor_si512(mid, _mm512_clmulepi64_epi128(x, y, 0x10));
+    }
+
+  __m128i sums[3];
+  __m512i lanes[3] = {lo, mid, hi};
+  for (int j = 0; j < 3; j++)
+    sums[j] = _mm512_extracti32x4_epi32(lanes[j], 0)
+        ^ _mm512_extracti32x4_epi32(lanes[j], 1)
+        ^ _mm512_extracti32x4_epi32(lanes[j], 2)
+        ^ _mm512_extracti32x4_epi32(lanes[j], 3);
+  res[0] ^= sums[0] ^ _mm_slli_si128(sums[1], 8);
+  res[1] ^= sums[2] ^ _mm_srli_si128(sums[1], 8);
+
+  add_mul128_generic(res, a + i, b + i, n - i);
+}
+#endif
+
+void add_mul128_vpclmul(__m128i res[2], const __m128i* a, const __m128i* b,
+    size_t n)
+{
+#ifdef __x86_64__
+  if (cpu_has_vpclmul())
+    add_mul128_avx512(res, a, b, n);
+  else
+#endif
+    {
+      (void) res, (void) a, (void) b, (void) n;
+      throw runtime_error("need VPCLMULQDQ support");
+    }
+}
+
+void add_mul64(__m128i& res, const word* a, const word* b, size_t n)
+{
+  if (n >= 8 and cpu_has_vpclmul())
+    add_mul64_vpclmul(res, a, b, n);
+  else
+    add_mul64_generic(res, a, b, n);
+}
+
+void add_mul64_generic(__m128i& res, const word* a, const word* b, size_t n)
+{
+  for (size_t i = 0; i < n; i++)
+    res ^= clmul<0>(_mm_cvtsi64_si128(a[i]), _mm_cvtsi64_si128(b[i]));
+}
+
+#ifdef __x86_64__
+// eight products per two instructions, one lane reduction at the end
+__attribute__((target("avx512f,vpclmulqdq")))
+static void add_mul64_avx512(__m128i& res, const word* a, const word* b,
+    size_t n)
+{
+  __m512i sum = _mm512_setzero_si512();
+  size_t i;
+  for (i = 0; i + 8 <= n; i += 8)
+    {
+      __m512i x = _mm512_loadu_si512(a + i);
+      __m512i y = _mm512_loadu_si512(b + i);
+      sum = _mm512_xor_si512(sum, _mm512_clmulepi64_epi128(x, y, 0x00));
+      sum = _mm512_xor_si512(sum, _mm512_clmulepi64_epi128(x, y, 0x11));
+    }
+
+  res ^= _mm512_extracti32x4_epi32(sum, 0) ^ _mm512_extracti32x4_epi32(sum, 1)
+      ^ _mm512_extracti32x4_epi32(sum, 2) ^ _mm512_extracti32x4_epi32(sum, 3);
+
+  add_mul64_generic(res, a + i, b + i, n - i);
+}
+#endif
+
+void add_mul64_vpclmul(__m128i& res, const word* a, const word* b, size_t n)
+{
+#ifdef __x86_64__
+  if (cpu_has_vpclmul())
+    add_mul64_avx512(res, a, b, n);
+  else
+#endif
+    {
+      (void) res, (void) a, (void) b, (void) n;
+      throw runtime_error("need VPCLMULQDQ support");
+    }
+}
+
 ostream& operator<<(ostream& s, const int128& a)
 {
   word* tmp = (word*)&a.a;
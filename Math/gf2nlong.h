@@ -247,6 +247,18 @@ inline void mul128(__m128i a, __m128i b, __m128i *res1, __m128i *res2)
     *res2 = tmp6;
 }
 
+// res += sum_i a[i] * b[i] without reduction, using VPCLMULQDQ if available
+void add_mul128(__m128i res[2], const __m128i* a, const __m128i* b, size_t n);
+void add_mul128_generic(__m128i res[2], const __m128i* a, const __m128i* b,
+        size_t n);
+void add_mul128_vpclmul(__m128i res[2], const __m128i* a, const __m128i* b,
+        size_t n);
+
+// res += sum_i a[i] * b[i] for 64-bit polynomials without reduction
+void add_mul64(__m128i& res, const word* a, const word* b, size_t n);
+void add_mul64_generic(__m128i& res, const word* a, const word* b, size_t n);
+void add_mul64_vpclmul(__m128i& res, const word* a, const word* b, size_t n);
+
 inline void mul(int128 a, int128 b, int128& lo, int128& hi)
 {
     mul128(a.a, b.a, &lo.a, &hi.a);
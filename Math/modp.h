@@ -169,6 +169,8 @@ inline void Mul(modp_<L>& ans,const modp_<L>& x,const modp_<L>& y,const Zp_Data&
 {
   if (ZpD.montgomery)
     { ZpD.Mont_Mult_max(ans.x,x.x,y.x,L); }
+  else if (ZpD.is_solinas())
+    { ZpD.Solinas_Mult(ans.x,x.x,y.x); }
   else
     { //ans.x=(x.x*y.x)%ZpD.pr;
       mp_limb_t aa[2*L],q[2*L];
@@ -183,6 +185,8 @@ inline void modp_<L>::mul(const modp_<L>& x, const modp_<L>& y, const Zp_Data& Z
 {
   if (ZpD.montgomery)
     ZpD.Mont_Mult_<T>(this->x, x.x, y.x);
+  else if (ZpD.is_solinas() and ZpD.t == T)
+    ZpD.Solinas_Mult_<T>(this->x, x.x, y.x);
   else
     Mul<L>(*this, x, y, ZpD);
 }
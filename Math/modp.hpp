@@ -263,6 +263,8 @@ void Sqr(modp_<L>& ans,const modp_<L>& x,const Zp_Data& ZpD)
 { 
   if (ZpD.montgomery)
     { ZpD.Mont_Mult(ans.x,x.x,x.x); }
+  else if (ZpD.is_solinas())
+    { ZpD.Solinas_Mult(ans.x,x.x,x.x); }
   else
     { //ans.x=(x.x*x.x)%ZpD.pr;
       mp_limb_t aa[2*L],q[2*L];
@@ -9,6 +9,7 @@
 #include "Tools/random.h"
 #include "Tools/BitVector.h"
 #include "Tools/intrinsics.h"
+#include "Tools/cpu_support.h"
 #include "Math/Square.h"
 
 union matrix16x8
@@ -154,8 +155,100 @@ const int perm[] = { 0, 8, 4, 0xc, 2, 0xa, 6, 0xe, 1, 9, 5, 0xd, 3, 0xb, 7, 0xf
 const int perm2[] = { 0, 4, 2, 6, 1, 5, 3, 7, 8, 0xc, 0xa, 0xe, 9, 0xd, 0xb, 0xf };
 #endif
 
-UNROLL_LOOPS
+#ifdef __x86_64__
+#define AVX512_TARGET __attribute__((target("avx512f,avx512bw")))
+
+// swap the upper-right and lower-left S x S blocks in a row pair
+template<int S>
+AVX512_TARGET
+inline void swap_blocks(__m512i& a, __m512i& b, __m512i mask)
+{
+    __m512i t = _mm512_and_si512(
+            _mm512_xor_si512(_mm512_srli_epi64(a, S), b), mask);
+    b = _mm512_xor_si512(b, t);
+    a = _mm512_xor_si512(a, _mm512_slli_epi64(t, S));
+}
+
+// 32 registers with four rows each, pairs S/4 registers apart
+template<int S>
+AVX512_TARGET
+inline void swap_registers(__m512i* x, long long mask)
+{
+    __m512i m = _mm512_set1_epi64(mask);
+    for (int i = 0; i < 32; i++)
+        if (not (i & (S / 4)))
+            swap_blocks<S>(x[i], x[i + S / 4], m);
+}
+
+// pairs within registers, PERM swaps the partner lanes
+template<int S, int PERM, int LOWER>
+AVX512_TARGET
+inline void swap_lanes(__m512i* x, long long mask)
+{
+    __m512i m = _mm512_set1_epi64(mask);
+    for (int i = 0; i < 32; i++)
+    {
+        __m512i t = _mm512_and_si512(
+                _mm512_xor_si512(_mm512_srli_epi64(x[i], S),
+                        _mm512_shuffle_i64x2(x[i], x[i], PERM)), m);
+        x[i] = _mm512_xor_si512(x[i],
+                _mm512_mask_blend_epi64(LOWER,
+                        _mm512_shuffle_i64x2(t, t, PERM),
+                        _mm512_slli_epi64(t, S)));
+    }
+}
+
+// recursive block swapping on the whole matrix in registers
+UNROLL_LOOPS AVX512_TARGET
+static void transpose_avx512(square128& square)
+{
+    __m512i x[32];
+    for (int i = 0; i < 32; i++)
+        x[i] = _mm512_loadu_si512(&square.rows[4 * i]);
+
+    __m512i lower = _mm512_set_epi64(0, -1, 0, -1, 0, -1, 0, -1);
+    for (int i = 0; i < 16; i++)
+    {
+        __m512i& a = x[i];
+        __m512i& b = x[i + 16];
+        __m512i t = _mm512_and_si512(
+                _mm512_xor_si512(_mm512_bsrli_epi128(a, 8), b), lower);
+        b = _mm512_xor_si512(b, t);
+        a = _mm512_xor_si512(a, _mm512_bslli_epi128(t, 8));
+    }
+
+    swap_registers<32>(x, 0x00000000FFFFFFFF);
+    swap_registers<16>(x, 0x0000FFFF0000FFFF);
+    swap_registers<8>(x, 0x00FF00FF00FF00FF);
+    swap_registers<4>(x, 0x0F0F0F0F0F0F0F0F);
+    swap_lanes<2, 0x4E, 0x0F>(x, 0x3333333333333333);
+    swap_lanes<1, 0xB1, 0x33>(x, 0x5555555555555555);
+
+    for (int i = 0; i < 32; i++)
+        _mm512_storeu_si512(&square.rows[4 * i], x[i]);
+}
+#endif
+
 void square128::transpose()
+{
+    if (cpu_has_avx512())
+        transpose_avx512();
+    else
+        transpose_generic();
+}
+
+void square128::transpose_avx512()
+{
+#ifdef __x86_64__
+    if (cpu_has_avx512())
+        ::transpose_avx512(*this);
+    else
+#endif
+        throw runtime_error("need AVX-512 support");
+}
+
+UNROLL_LOOPS
+void square128::transpose_generic()
 {
 #ifdef USE_SUBSQUARES
     for (int j = 0; j < N_SUBSQUARES; j++)
@@ -268,7 +361,48 @@ void square128::randomize(int row, PRNG& G)
 }
 
 
+#ifdef __x86_64__
+// masked XOR on four rows at a time instead of branching on every bit
+AVX512_TARGET
+static void conditional_add_avx512(square128& square, int128 conditions,
+        const square128& other)
+{
+    for (int i = 0; i < 32; i++)
+    {
+        word bits = (conditions.get_half(i / 16) >> (4 * (i % 16))) & 0xF;
+        // one mask bit per 64-bit half of a row
+        bits = (bits | (bits << 2)) & 0x33;
+        bits = (bits | (bits << 1)) & 0x55;
+        __mmask8 mask = bits * 3;
+        __m512i x = _mm512_loadu_si512(&square.rows[4 * i]);
+        __m512i y = _mm512_loadu_si512(&other.rows[4 * i]);
+        _mm512_storeu_si512(&square.rows[4 * i],
+                _mm512_mask_xor_epi64(x, mask, x, y));
+    }
+}
+#endif
+
 void square128::conditional_add(BitVector& conditions, square128& other, int offset)
+{
+    if (cpu_has_avx512())
+        conditional_add_avx512(conditions, other, offset);
+    else
+        conditional_add_generic(conditions, other, offset);
+}
+
+void square128::conditional_add_avx512(BitVector& conditions,
+        square128& other, int offset)
+{
+#ifdef __x86_64__
+    if (cpu_has_avx512())
+        ::conditional_add_avx512(*this, conditions.get_int128(offset), other);
+    else
+#endif
+        throw runtime_error("need AVX-512 support");
+}
+
+void square128::conditional_add_generic(BitVector& conditions,
+        square128& other, int offset)
 {
     for (int i = 0; i < 128; i++)
         if (conditions.get_bit(128 * offset + i))
@@ -278,13 +412,7 @@ void square128::conditional_add(BitVector& conditions, square128& other, int off
 template <>
 void Square<gf2n_long>::to(gf2n_long& result, false_type)
 {
-    int128 high, low;
-    for (int i = 0; i < gf2n_long::degree(); i++)
-    {
-        low ^= rows[i].get() << i;
-        high ^= rows[i].get() >> (128 - i);
-    }
-    result.reduce(high, low);
+    result = gf2n_long::dot_product(rows, monomials(), gf2n_long::degree());
 }
 
 void square128::check_transpose(square128& dual, int i, int k)
@@ -64,7 +64,13 @@ union square128 {
     void randomize(PRNG& G);
     void randomize(int row, PRNG& G);
     void conditional_add(BitVector& conditions, square128& other, int offset);
+    void conditional_add_generic(BitVector& conditions, square128& other,
+            int offset);
+    void conditional_add_avx512(BitVector& conditions, square128& other,
+            int offset);
     void transpose();
+    void transpose_generic();
+    void transpose_avx512();
     template <class T>
     void to(T& result);
 
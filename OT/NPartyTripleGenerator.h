@@ -43,6 +43,9 @@ public:
     void unlock();
     void signal();
     void wait();
+
+    // unique among generators using the same player
+    static string helper_id(Player& P);
 };
 
 template<class T>
@@ -73,11 +76,15 @@ protected:
     void signal_multipliers(MultJob job);
     void wait_for_multipliers();
 
+    // additional connections for OT extension threads
+    vector<Player*> helper_players;
+
     typename T::Multiplier* new_multiplier(int i);
 
 public:
     // TwoPartyPlayer's for OTs, n-party Player for sacrificing
     vector<TwoPartyPlayer*> players;
+    vector<vector<TwoPartyPlayer*>> ot_helpers;
     vector<typename T::Multiplier*> ot_multipliers;
     //vector<OTMachine*> machines;
     BitVector baseReceiverInput; // same for every set of OTs
@@ -6,6 +6,9 @@
 #include "OT/OTExtensionWithMatrix.h"
 #include "OT/OTMultiplier.h"
 #include "Tools/Subroutines.h"
+#include "Tools/Lock.h"
+#include "Networking/CryptoPlayer.h"
+#include "Processor/OnlineOptions.h"
 #include "Protocols/MAC_Check.h"
 #include "GC/SemiSecret.h"
 #include "GC/SemiPrep.h"
@@ -124,6 +127,29 @@ OTTripleGenerator<T>::OTTripleGenerator(const OTTripleSetup& setup,
         players[i] = new VirtualTwoPartyPlayer(globalPlayer, other_player);
     }
 
+    // extra connections only with several OT threads per pair
+    int ot_threads = OnlineOptions::singleton.ot_threads;
+    if (ot_threads > 1)
+    {
+        string id = helper_id(globalPlayer);
+        for (int k = 1; k < ot_threads; k++)
+        {
+            string helper = id + "-" + to_string(k);
+            if (globalPlayer.is_encrypted())
+                helper_players.push_back(
+                        new CryptoPlayer(globalPlayer.N, helper));
+            else
+                helper_players.push_back(
+                        new PlainPlayer(globalPlayer.N, helper));
+        }
+    }
+
+    ot_helpers.resize(n-1);
+    for (int i = 0; i < n-1; i++)
+        for (auto helper : helper_players)
+            ot_helpers[i].push_back(new VirtualTwoPartyPlayer(*helper,
+                    players[i]->other_player_num()));
+
     pthread_mutex_init(&mutex, 0);
     pthread_cond_init(&ready, 0);
 
@@ -156,6 +182,15 @@ OTTripleGenerator<T>::~OTTripleGenerator()
 
     for (size_t i = 0; i < players.size(); i++)
         delete players[i];
+    for (auto& helpers : ot_helpers)
+        for (auto helper : helpers)
+            delete helper;
+    for (auto helper : helper_players)
+    {
+        for (size_t i = 0; i < helper->thread_stats.size(); i++)
+            globalPlayer.thread_stats.at(i) += helper->thread_stats[i];
+        delete helper;
+    }
     //delete nplayer;
     pthread_mutex_destroy(&mutex);
     pthread_cond_destroy(&ready);
@@ -926,6 +961,16 @@ void OTTripleGenerator<T>::print_progress(int k)
     }
 }
 
+inline
+string GeneratorThread::helper_id(Player& P)
+{
+    static map<string, int> counters;
+    static Lock lock;
+    ScopeLock _(lock);
+    string id = P.get_id();
+    return "ot" + id + "-" + to_string(counters[id]++);
+}
+
 inline
 void GeneratorThread::lock()
 {
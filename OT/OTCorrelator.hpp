@@ -144,7 +144,15 @@ void OTExtensionWithMatrix::hash_outputs(int nOTs, vector<V>& senderOutput,
     if (nOTs % 8 != 0)
         throw runtime_error("number of OTs must be divisible by 8");
 
-    for (int i = 0; i < nOTs; i += 8)
+    // hash as many rows as possible at once while staying within squares
+    int step = 8;
+    while (step < 128 and n_rows % (2 * step) == 0 and nOTs % (2 * step) == 0)
+        step *= 2;
+    vector<int128> tmp[2];
+    for (auto& x : tmp)
+        x.resize(step);
+
+    for (int i = 0; i < nOTs; i += step)
     {
         int i_outer_input = i / 128;
         int i_inner_input = i % 128;
@@ -152,8 +160,7 @@ void OTExtensionWithMatrix::hash_outputs(int nOTs, vector<V>& senderOutput,
         int i_inner_output = i % n_rows;
         if (ot_role & SENDER)
         {
-            int128 tmp[2][8];
-            for (int j = 0; j < 8; j++)
+            for (int j = 0; j < step; j++)
             {
                 tmp[0][j] = senderOutputMatrices[0].squares[i_outer_input].rows[i_inner_input + j];
                 if (correlated)
@@ -163,15 +170,16 @@ void OTExtensionWithMatrix::hash_outputs(int nOTs, vector<V>& senderOutput,
                             senderOutputMatrices[1].squares[i_outer_input].rows[i_inner_input + j];
             }
             for (int j = 0; j < 2; j++)
-                mmo.hashEightBlocks(
+                mmo.hashManyBlocks(
                         &senderOutput[j].squares[i_outer_output].rows[i_inner_output],
-                        &tmp[j]);
+                        tmp[j].data(), step);
         }
         if (ot_role & RECEIVER)
         {
-            mmo.hashEightBlocks(
+            mmo.hashManyBlocks(
                     &receiverOutput.squares[i_outer_output].rows[i_inner_output],
-                    &receiverOutputMatrix.squares[i_outer_input].rows[i_inner_input]);
+                    &receiverOutputMatrix.squares[i_outer_input].rows[i_inner_input],
+                    step);
         }
     }
     //cout << "done.\n";
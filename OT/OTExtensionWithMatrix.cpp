@@ -5,6 +5,9 @@
 
 #include "OTExtensionWithMatrix.h"
 #include "Tools/Bundle.h"
+#include "Processor/OnlineOptions.h"
+
+#include <thread>
 
 #ifndef USE_KOS
 #include "Networking/PlayerCtSocket.h"
@@ -44,9 +47,16 @@ OTExtensionWithMatrix::~OTExtensionWithMatrix()
 #ifndef USE_KOS
     if (channel)
         delete channel;
+    for (auto helper_channel : helper_channels)
+        delete helper_channel;
 #endif
 }
 
+void OTExtensionWithMatrix::set_helpers(const vector<TwoPartyPlayer*>& players)
+{
+    helpers = players;
+}
+
 void OTExtensionWithMatrix::protocol_agreement()
 {
     if (agreed)
@@ -56,7 +66,9 @@ void OTExtensionWithMatrix::protocol_agreement()
 #ifdef USE_KOS
     bundle.mine = string("KOS15");
 #else
-    bundle.mine = string("SoftSpokenOT");
+    // the field size changes the messages
+    bundle.mine = string("SoftSpokenOT")
+            + to_string(OnlineOptions::singleton.soft_spoken_bits);
 #endif
     player->unchecked_broadcast(bundle);
 
@@ -68,6 +80,9 @@ void OTExtensionWithMatrix::protocol_agreement()
     {
         cerr << "Parties compiled with different OT extensions" << endl;
         cerr << "Set \"USE_KOS\" to the same value on all parties" << endl;
+#ifndef USE_KOS
+        cerr << "and use the same --soft-spoken on all parties" << endl;
+#endif
         exit(1);
     }
 }
@@ -117,16 +132,11 @@ void OTExtensionWithMatrix::extend(int nOTs_requested, const BitVector& newRecei
     if (not channel)
         channel = new osuCrypto::Channel(ot_extension_ios, new PlayerCtSocket(*player));
 
-    if (player->my_num())
-    {
-        soft_sender(nOTs_requested);
-        soft_receiver(nOTs_requested, newReceiverInput);
-    }
+    if (helpers.empty())
+        soft_extend(nOTs_requested, 0, sender_base(), receiver_base(),
+                newReceiverInput, *channel);
     else
-    {
-        soft_receiver(nOTs_requested, newReceiverInput);
-        soft_sender(nOTs_requested);
-    }
+        parallel_soft_extend(nOTs_requested, newReceiverInput);
 
     channel->send("hello", 6);
     char buf[6];
@@ -136,52 +146,164 @@ void OTExtensionWithMatrix::extend(int nOTs_requested, const BitVector& newRecei
 }
 
 #ifndef USE_KOS
+vector<int128> OTExtensionWithMatrix::sender_base()
+{
+    vector<int128> res;
+    if (ot_role & SENDER)
+        for (auto& x : G_receiver)
+            res.push_back(x.get_doubleword());
+    return res;
+}
+
+vector<array<int128, 2>> OTExtensionWithMatrix::receiver_base()
+{
+    vector<array<int128, 2>> res;
+    if (ot_role & RECEIVER)
+        for (auto& x : G_sender)
+        {
+            res.push_back({});
+            for (int i = 0; i < 2; i++)
+                res.back()[i] = x[i].get_doubleword();
+        }
+    return res;
+}
+
 void OTExtensionWithMatrix::soft_sender(size_t n)
+{
+    soft_sender(n, 0, sender_base(), *channel);
+}
+
+void OTExtensionWithMatrix::soft_receiver(size_t n,
+        const BitVector& newReceiverInput)
+{
+    soft_receiver(n, 0, receiver_base(), newReceiverInput, *channel);
+}
+
+void OTExtensionWithMatrix::soft_extend(size_t n, size_t start,
+        const vector<int128>& sender_base,
+        const vector<array<int128, 2>>& receiver_base,
+        const BitVector& newReceiverInput, osuCrypto::Channel& channel)
+{
+    // opposite order to avoid deadlock
+    if (player->my_num())
+    {
+        soft_sender(n, start, sender_base, channel);
+        soft_receiver(n, start, receiver_base, newReceiverInput, channel);
+    }
+    else
+    {
+        soft_receiver(n, start, receiver_base, newReceiverInput, channel);
+        soft_sender(n, start, sender_base, channel);
+    }
+}
+
+/*
+ * Split the OTs in whole squares among threads, each with an independent
+ * SoftSpokenOT instance on its own connection. The base OTs are drawn
+ * from the seeded generators in the same order by both parties.
+ */
+void OTExtensionWithMatrix::parallel_soft_extend(size_t n,
+        const BitVector& newReceiverInput)
+{
+    int n_threads = helpers.size() + 1;
+    size_t n_squares = DIV_CEIL(n, 128);
+    size_t step = DIV_CEIL(n_squares, n_threads) * 128;
+
+    while (helper_channels.size() < helpers.size())
+        helper_channels.push_back(
+                new osuCrypto::Channel(ot_extension_ios,
+                        new PlayerCtSocket(*helpers[helper_channels.size()])));
+
+    vector<vector<int128>> sender_bases;
+    vector<vector<array<int128, 2>>> receiver_bases;
+    vector<BitVector> inputs;
+    for (size_t start = 0; start < n; start += step)
+    {
+        sender_bases.push_back(sender_base());
+        receiver_bases.push_back(receiver_base());
+        size_t size = min(step, n - start);
+        inputs.push_back(BitVector(size));
+        if (ot_role & RECEIVER)
+            for (size_t i = 0; i < size; i++)
+                inputs.back().set_bit(i, newReceiverInput.get_bit(start + i));
+    }
+
+    vector<thread> threads;
+    vector<string> errors(inputs.size());
+    for (size_t i = 1; i < inputs.size(); i++)
+        threads.push_back(thread([&, i]() {
+            try
+            {
+                soft_extend(inputs[i].size(), i * step, sender_bases[i],
+                        receiver_bases[i], inputs[i], *helper_channels[i - 1]);
+            }
+            catch (exception& e)
+            {
+                errors[i] = e.what();
+            }
+        }));
+
+    soft_extend(inputs[0].size(), 0, sender_bases[0], receiver_bases[0],
+            inputs[0], *channel);
+
+    for (auto& thread : threads)
+        thread.join();
+
+    for (auto& error : errors)
+        if (not error.empty())
+            throw runtime_error("error in OT extension thread: " + error);
+}
+
+void OTExtensionWithMatrix::soft_sender(size_t n, size_t start,
+        const vector<int128>& base, osuCrypto::Channel& channel)
 {
     if (not (ot_role & SENDER))
         return;
 
     osuCrypto::PRNG prng(osuCrypto::sysRandomSeed());
-    osuCrypto::SoftSpokenOT::TwoOneMaliciousSender sender(2);
+    osuCrypto::SoftSpokenOT::TwoOneMaliciousSender sender(
+            OnlineOptions::singleton.soft_spoken_bits);
 
     vector<osuCrypto::block> outputs;
-    for (auto& x : G_receiver)
+    for (auto& x : base)
     {
-        outputs.push_back(x.get_doubleword());
+        outputs.push_back(x.a);
     }
     sender.setBaseOts(outputs,
             {baseReceiverInput.get_ptr(), sender.baseOtCount()}, prng,
-            *channel);
+            channel);
 
     // Choose which messages should be sent.
     auto sendMessages = osuCrypto::allocAlignedBlockArray<std::array<osuCrypto::block, 2>>(n);
 
     // Send the messages.
-    sender.send(gsl::span(sendMessages.get(), n), prng, *channel);
+    sender.send(gsl::span(sendMessages.get(), n), prng, channel);
 
     for (size_t i = 0; i < n; i++)
         for (int j = 0; j < 2; j++)
-            senderOutputMatrices[j].squares.at(i / 128).rows[i % 128] =
+            senderOutputMatrices[j].squares.at((start + i) / 128).rows[(start + i) % 128] =
                     sendMessages[i][j];
 }
 
-void OTExtensionWithMatrix::soft_receiver(size_t n,
-        const BitVector& newReceiverInput)
+void OTExtensionWithMatrix::soft_receiver(size_t n, size_t start,
+        const vector<array<int128, 2>>& base,
+        const BitVector& newReceiverInput, osuCrypto::Channel& channel)
 {
     if (not (ot_role & RECEIVER))
         return;
 
     osuCrypto::PRNG prng(osuCrypto::sysRandomSeed());
-    osuCrypto::SoftSpokenOT::TwoOneMaliciousReceiver recver(2);
+    osuCrypto::SoftSpokenOT::TwoOneMaliciousReceiver recver(
+            OnlineOptions::singleton.soft_spoken_bits);
 
     vector<array<osuCrypto::block, 2>> inputs;
-    for (auto& x : G_sender)
+    for (auto& x : base)
     {
         inputs.push_back({});
         for (int i = 0; i < 2; i++)
-            inputs.back()[i] = x[i].get_doubleword();
+            inputs.back()[i] = x[i].a;
     }
-    recver.setBaseOts(inputs, prng, *channel);
+    recver.setBaseOts(inputs, prng, channel);
 
     // Choose which messages should be received.
     osuCrypto::BitVector choices(n);
@@ -192,11 +314,11 @@ void OTExtensionWithMatrix::soft_receiver(size_t n,
 
     // Receive the messages
     std::vector<osuCrypto::block, osuCrypto::AlignedBlockAllocator> messages(n);
-    recver.receive(choices, messages, prng, *channel);
+    recver.receive(choices, messages, prng, channel);
 
     for (size_t i = 0; i < n; i++)
     {
-        receiverOutputMatrix.squares.at(i / 128).rows[i % 128] = messages[i];
+        receiverOutputMatrix.squares.at((start + i) / 128).rows[(start + i) % 128] = messages[i];
     }
 }
 #endif
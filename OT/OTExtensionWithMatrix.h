@@ -59,8 +59,12 @@ class OTExtensionWithMatrix : public OTCorrelator<BitMatrix>
 
 #ifndef USE_KOS
     osuCrypto::Channel* channel;
+    vector<osuCrypto::Channel*> helper_channels;
 #endif
 
+    // separate connections for splitting extend() among threads
+    vector<TwoPartyPlayer*> helpers;
+
     bool agreed;
 
 public:
@@ -99,6 +103,8 @@ public:
     void hash_outputs(int nOTs, vector<V>& senderOutput, V& receiverOutput,
             bool correlated = true);
 
+    void set_helpers(const vector<TwoPartyPlayer*>& players);
+
     // SoftSpokenOT
     void soft_sender(size_t nOTs);
     void soft_receiver(size_t nOTs, const BitVector& newReceiverInput);
@@ -117,6 +123,21 @@ public:
     octet* get_sender_output(int choice, int i);
 
 protected:
+#ifndef USE_KOS
+    void soft_sender(size_t nOTs, size_t start, const vector<int128>& base,
+            osuCrypto::Channel& channel);
+    void soft_receiver(size_t nOTs, size_t start,
+            const vector<array<int128, 2>>& base,
+            const BitVector& newReceiverInput, osuCrypto::Channel& channel);
+    void soft_extend(size_t nOTs, size_t start,
+            const vector<int128>& sender_base,
+            const vector<array<int128, 2>>& receiver_base,
+            const BitVector& newReceiverInput, osuCrypto::Channel& channel);
+    void parallel_soft_extend(size_t nOTs, const BitVector& newReceiverInput);
+    vector<int128> sender_base();
+    vector<array<int128, 2>> receiver_base();
+#endif
+
     void hash_outputs(int nOTs);
 
     void check_correlation(int nOTs,
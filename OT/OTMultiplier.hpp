@@ -27,6 +27,7 @@ OTMultiplier<T>::OTMultiplier(OTTripleGenerator<T>& generator,
         otCorrelator(generator.players[thread_num], BOTH, true)
 {
     this->thread = 0;
+    rot_ext.set_helpers(generator.ot_helpers.at(thread_num));
     rot_ext.init(generator.baseReceiverInput,
             generator.baseSenderInputs[thread_num],
             generator.baseReceiverOutputs[thread_num]);
@@ -118,16 +118,16 @@ void OTVoleBase<T>::hash_row(__m128i res[2], const U& row,
 	{
 		for (int j = 0; j < 16; j++)
 			memcpy((char*) buffer + j * T::size(), row[next++].get_ptr(), T::size());
-		for (int j = 0; j < T::size(); j++)
-			add_mul(res, buffer[j], *coefficients++);
+		add_mul128(res, buffer, coefficients, T::size());
+		coefficients += T::size();
 	}
 	for (int j = 0; j < 16; j++)
 		if (next < row.size())
 			memcpy((char*) buffer + j * T::size(), row[next++].get_ptr(), T::size());
 		else
 		    memset((char*) buffer + j * T::size(), 0, T::size());
-	for (int j = 0; j < num_blocks % T::size(); j++)
-		add_mul(res, buffer[j], *coefficients++);
+	add_mul128(res, buffer, coefficients, num_blocks % T::size());
+	coefficients += num_blocks % T::size();
 	assert(coefficients == coeff_base + num_blocks);
 }
 
@@ -146,10 +146,14 @@ inline
 void OTVoleBase<Z2<128>>::hash_row(__m128i res[2],
 		const U& row, const __m128i* coefficients)
 {
-	for (size_t i = 0; i < row.size(); i++)
+	const int n_buffer = 16;
+	__m128i buffer[n_buffer];
+	for (size_t i = 0; i < row.size(); i += n_buffer)
 	{
-		__m128i block = int128(row[i].get_limb(1), row[i].get_limb(0)).a;
-		add_mul(res, block, coefficients[i]);
+		size_t n = min(row.size() - i, size_t(n_buffer));
+		for (size_t j = 0; j < n; j++)
+			buffer[j] = int128(row[i + j].get_limb(1), row[i + j].get_limb(0)).a;
+		add_mul128(res, buffer, coefficients + i, n);
 	}
 }
 
@@ -159,27 +163,32 @@ inline
 void OTVoleBase<Z2<192>>::hash_row(__m128i res[2], const U& row,
 		const __m128i* coefficients)
 {
-	__m128i block;
+	// two elements in three blocks, four times per buffer
+	const int n_buffer = 12;
+	__m128i buffer[n_buffer];
+	int n = 0;
 	size_t j;
-	for (j = 0; j < row.size() - 1; j += 2)
+	for (j = 0; j + 1 < row.size(); j += 2)
 	{
 		auto x = row[j];
 		auto y = row[j + 1];
-		block = int128(x.get_limb(1), x.get_limb(0)).a;
-		add_mul(res, block, *coefficients++);
-		block = int128(y.get_limb(0), x.get_limb(2)).a;
-		add_mul(res, block, *coefficients++);
-		block = int128(y.get_limb(2), y.get_limb(1)).a;
-		add_mul(res, block, *coefficients++);
+		buffer[n++] = int128(x.get_limb(1), x.get_limb(0)).a;
+		buffer[n++] = int128(y.get_limb(0), x.get_limb(2)).a;
+		buffer[n++] = int128(y.get_limb(2), y.get_limb(1)).a;
+		if (n == n_buffer)
+		{
+			add_mul128(res, buffer, coefficients, n);
+			coefficients += n;
+			n = 0;
+		}
 	}
 	if (j < row.size())
 	{
 		auto x = row[j];
-		block = int128(x.get_limb(1), x.get_limb(0)).a;
-		add_mul(res, block, *coefficients++);
-		block = int128(x.get_limb(2)).a;
-		add_mul(res, block, *coefficients++);
+		buffer[n++] = int128(x.get_limb(1), x.get_limb(0)).a;
+		buffer[n++] = int128(x.get_limb(2)).a;
 	}
+	add_mul128(res, buffer, coefficients, n);
 }
 
 template <class T>
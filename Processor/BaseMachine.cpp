@@ -18,6 +18,10 @@ using namespace std;
 BaseMachine* BaseMachine::singleton = 0;
 thread_local int BaseMachine::thread_num;
 thread_local OnDemandOTTripleSetup BaseMachine::ot_setup;
+thread_local map<pair<string, Dtype>, RefillStats> BaseMachine::refill_stats;
+thread_local int BaseMachine::current_tape = -1;
+thread_local map<int, DataPositions> BaseMachine::tape_usage;
+thread_local const DataPositions* BaseMachine::current_usage = 0;
 
 void print_usage(ostream& o, const char* name, size_t capacity)
 {
@@ -70,6 +74,45 @@ int BaseMachine::bucket_size(size_t usage)
   return res;
 }
 
+void BaseMachine::count_refill(const string& type_string, Dtype type,
+    size_t n_items)
+{
+  auto& stats = refill_stats[{type_string, type}];
+  stats.rounds++;
+  stats.generated += n_items;
+}
+
+void BaseMachine::start_tape(int tape, const DataPositions* usage)
+{
+  current_tape = tape;
+  current_usage = usage;
+}
+
+void BaseMachine::finish_tape(const DataPositions& usage)
+{
+  if (current_tape >= 0)
+    tape_usage[current_tape] = usage;
+  current_tape = -1;
+  current_usage = 0;
+}
+
+void BaseMachine::print_refills(const string& type_string, Dtype type,
+    size_t left)
+{
+  auto it = refill_stats.find({type_string, type});
+  if (it == refill_stats.end())
+    return;
+
+  auto& stats = it->second;
+  if (OnlineOptions::singleton.verbose)
+    cerr << "\t" << stats.rounds << " refill rounds of "
+        << DataPositions::dtype_names[type] << " of " << type_string
+        << " generating " << stats.generated << " (" << left << " wasted)"
+        << endl;
+
+  refill_stats.erase(it);
+}
+
 BaseMachine::BaseMachine() : nthreads(0)
 {
   if (sodium_init() == -1)
@@ -20,6 +20,19 @@ using namespace std;
 
 void print_usage(ostream& o, const char* name, size_t capacity);
 
+/**
+ * Refill accounting per share type and data type
+ * (items actually produced in this thread)
+ */
+class RefillStats
+{
+public:
+    int rounds;
+    size_t generated;
+
+    RefillStats() : rounds(0), generated(0) {}
+};
+
 class BaseMachine
 {
 protected:
@@ -39,6 +52,21 @@ protected:
 
     static BaseMachine get_basics(string progname);
 
+    static thread_local map<pair<string, Dtype>, RefillStats> refill_stats;
+
+    // items consumed by the last run of every tape in this thread
+    static thread_local int current_tape;
+    static thread_local map<int, DataPositions> tape_usage;
+    // items consumed so far by the current run
+    static thread_local const DataPositions* current_usage;
+
+    template<class T>
+    static long long demand(Dtype type, const DataPositions& usage);
+    template<class T>
+    static long long adaptive_cap(Dtype type);
+    template<class T>
+    static int adaptive_batch_size(Dtype type, int n_opts);
+
 public:
     static thread_local int thread_num;
 
@@ -67,10 +95,20 @@ public:
     static int batch_size(Dtype type, int buffer_size = 0, int fallback = 0);
     template<class T>
     static int edabit_batch_size(int n_bits, int buffer_size = 0);
+    template<class T>
+    static int bulk_batch_size(size_t n);
     static int edabit_bucket_size(int n_bits);
     static int triple_bucket_size(DataFieldType type);
     static int bucket_size(size_t usage);
 
+    static void count_refill(const string& type_string, Dtype type,
+            size_t n_items);
+    static void print_refills(const string& type_string, Dtype type,
+            size_t left);
+
+    static void start_tape(int tape, const DataPositions* usage = 0);
+    static void finish_tape(const DataPositions& usage);
+
     BaseMachine();
     virtual ~BaseMachine() {}
 
@@ -108,6 +146,8 @@ int BaseMachine::batch_size(Dtype type, int buffer_size, int fallback)
     int n_opts;
     int n = 0;
     int res = 0;
+    bool adaptive = buffer_size <= 0
+            and OnlineOptions::singleton.adaptive_batch > 0;
 
     if (buffer_size > 0)
         n_opts = buffer_size;
@@ -117,17 +157,7 @@ int BaseMachine::batch_size(Dtype type, int buffer_size, int fallback)
         n_opts = OnlineOptions::singleton.batch_size;
 
     if (buffer_size <= 0 and has_program())
-    {
-        auto files = s().progs[0].get_offline_data_used().files;
-        auto usage = files[T::clear::field_type()];
-
-        if (type == DATA_DABIT and T::LivePrep::bits_from_dabits())
-            n = usage[DATA_BIT] + usage[DATA_DABIT];
-        else if (type == DATA_BIT and T::LivePrep::dabits_from_bits())
-            n = usage[DATA_BIT] + usage[DATA_DABIT];
-        else
-            n = usage[type];
-    }
+        n = demand<T>(type, s().progs[0].get_offline_data_used());
     else if (type != DATA_DABIT)
     {
         n = buffer_size;
@@ -161,6 +191,9 @@ int BaseMachine::batch_size(Dtype type, int buffer_size, int fallback)
     else
         res = n_opts;
 
+    if (adaptive)
+        res = adaptive_batch_size<T>(type, n_opts);
+
 #ifdef DEBUG_BATCH_SIZE
     cerr << DataPositions::dtype_names[type] << " " << T::type_string()
             << " res=" << res << " n="
@@ -171,6 +204,82 @@ int BaseMachine::batch_size(Dtype type, int buffer_size, int fallback)
     return res;
 }
 
+template<class T>
+long long BaseMachine::demand(Dtype type, const DataPositions& usage)
+{
+    auto& files = usage.files[T::clear::field_type()];
+
+    if (type == DATA_DABIT and T::LivePrep::bits_from_dabits())
+        return files[DATA_BIT] + files[DATA_DABIT];
+    else if (type == DATA_BIT and T::LivePrep::dabits_from_bits())
+        return files[DATA_BIT] + files[DATA_DABIT];
+    else
+        return files[type];
+}
+
+// number of items in the memory given by --adaptive-batch
+template<class T>
+long long BaseMachine::adaptive_cap(Dtype type)
+{
+    size_t item_size = sizeof(T) * max(1, DataPositions::tuple_size[type]);
+    long long cap = ((long long) OnlineOptions::singleton.adaptive_batch << 20)
+            / item_size;
+    return max(1ll, min(cap, (long long) INT_MAX));
+}
+
+/**
+ * Batch size for a request of known size such as converting a long
+ * vector, within the memory cap of --adaptive-batch if given
+ * (edaBits are counted like daBits)
+ */
+template<class T>
+int BaseMachine::bulk_batch_size(size_t n)
+{
+    long long cap = INT_MAX;
+    if (OnlineOptions::singleton.adaptive_batch > 0)
+        cap = adaptive_cap<T>(DATA_DABIT);
+    return min(n, size_t(cap));
+}
+
+/**
+ * Batch size from the consumption of the tape run by this thread:
+ * what is left of the items consumed by its last run (or the compiler's
+ * count before the first run) in as few refills as the memory cap allows.
+ * Without a known consumption, or when the run uses more than
+ * expected, batches grow geometrically.
+ * This only depends on the program, so all parties agree.
+ */
+template<class T>
+int BaseMachine::adaptive_batch_size(Dtype type, int n_opts)
+{
+    long long cap = adaptive_cap<T>(type);
+
+    long long n = 0;
+    if (current_tape >= 0)
+    {
+        auto it = tape_usage.find(current_tape);
+        if (it != tape_usage.end())
+            n = demand<T>(type, it->second);
+        else if (has_program())
+            n = demand<T>(type,
+                    s().progs.at(current_tape).get_offline_data_used());
+    }
+
+    // items are counted before they are taken from the buffer,
+    // so the one that triggered the refill is still needed
+    if (n > 0 and current_usage)
+        n -= demand<T>(type, *current_usage) - 1;
+
+    long long res;
+    if (n > 0)
+        res = DIV_CEIL(n, DIV_CEIL(n, cap));
+    else
+        res = (long long) n_opts
+                << min(refill_stats[{T::type_string(), type}].rounds, 20);
+
+    return min(res, cap);
+}
+
 template<class T>
 int BaseMachine::edabit_batch_size(int n_bits, int buffer_size)
 {
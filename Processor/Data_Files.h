@@ -16,10 +16,13 @@
 #include "Tools/TimerWithComm.h"
 
 #include <fstream>
+#include <memory>
 #include <map>
 using namespace std;
 
 template<class T> class dabit;
+template<class T> class BufferScope;
+class BulkScope;
 
 namespace GC
 {
@@ -125,6 +128,8 @@ protected:
 
   T get_random_from_inputs(int nplayers);
 
+  unique_ptr<BulkScope> bulk_scope(size_t size, bool edabits);
+
 public:
   template<class U, class V>
   static Preprocessing<T>* get_new(Machine<U, V>& machine, DataPositions& usage,
@@ -173,6 +178,9 @@ public:
   /// Store fresh daBit in ``a`` (arithmetic part) and ``b`` (binary part)
   virtual void get_dabit(T& a, typename T::bit_type& b);
   virtual void get_dabit_no_count(T&, typename T::bit_type&) { throw runtime_error("no daBit"); }
+  /// Store ``size`` fresh daBits in ``a`` and bit-sliced from register ``reg`` in ``Sb``
+  virtual void get_dabits(size_t size, T* a,
+          vector<typename T::bit_type>& Sb, int reg);
   virtual void get_edabits(bool strict, size_t size, T* a,
           vector<typename T::bit_type>& Sb, const vector<int>& regs)
   { get_edabits<0>(strict, size, a, Sb, regs, T::clear::characteristic_two); }
@@ -321,6 +329,9 @@ class Data_Files
 
   void reset_usage() { usage.reset(); skipped.reset(); }
 
+  // counted while running, for adaptive batch sizes
+  const DataPositions& current_usage() { return usage; }
+
   void set_usage(const DataPositions& pos) { usage = pos; }
 
   TimerWithComm total_time();
@@ -22,6 +22,20 @@ public:
             int nplayers = 3);
 };
 
+/**
+ * Honest-majority field computation modulo a pseudo-Mersenne prime
+ * 2^k - c such as 2^61 - 1 or 2^127 - 1, which allows reduction by
+ * shifts and additions instead of Montgomery multiplication.
+ * The prime has to be set at compile time (``-P``).
+ */
+template<template<class T> class U, class V = HonestMajorityMachine>
+class SolinasFieldMachine
+{
+public:
+    SolinasFieldMachine(int argc, const char** argv, ez::ezOptionParser& opt,
+            int nplayers = 3);
+};
+
 template<template<class T> class U, template<class T> class V, class W, class X = gf2n>
 class FieldMachine
 {
@@ -29,6 +29,56 @@ HonestMajorityFieldMachine<T, V>::HonestMajorityFieldMachine(int argc,
             nplayers);
 }
 
+template<template<class U> class T, class V>
+SolinasFieldMachine<T, V>::SolinasFieldMachine(int argc, const char** argv,
+        ez::ezOptionParser& opt, int nplayers)
+{
+    OnlineOptions online_opts(opt, argc, argv, T<gfp0>());
+    V machine(argc, argv, opt, online_opts, gf2n(), nplayers);
+    if (online_opts.prime == 0)
+    {
+        cerr << "This protocol requires a pseudo-Mersenne prime, "
+                << "for example compile with '-P 2305843009213693951' "
+                << "for 2^61 - 1 or '-P 170141183460469231731687303715884105727' "
+                << "for 2^127 - 1" << endl;
+        exit(1);
+    }
+    if (not online_opts.live_prep)
+    {
+        cerr << "Preprocessing from files is stored in Montgomery "
+                << "representation, use live preprocessing" << endl;
+        exit(1);
+    }
+
+    bigint prime = online_opts.prime;
+    int n_limbs = online_opts.prime_limbs();
+    switch (n_limbs)
+    {
+#undef X
+#define X(L) \
+    case L: \
+        gfp_<0, L>::init_field(prime, false); \
+        if (not gfp_<0, L>::get_ZpD().is_solinas()) \
+        { \
+            cerr << prime << " is not of the form 2^k - c for small c" << endl; \
+            exit(1); \
+        } \
+        /* field already set up in standard representation */ \
+        online_opts.prime = 0; \
+        machine.template run<T<gfp_<0, L>>, T<gf2n>>(); \
+        break;
+    X(1) X(2)
+#ifndef FEWER_PRIMES
+    X(3) X(4)
+#endif
+#undef X
+    default:
+        cerr << "Not compiled for " << online_opts.prime_length()
+                << "-bit pseudo-Mersenne primes" << endl;
+        exit(1);
+    }
+}
+
 template<template<class U> class T, template<class U> class V, class W, class X>
 FieldMachine<T, V, W, X>::FieldMachine(int argc, const char** argv,
         ez::ezOptionParser& opt, OnlineOptions& online_opts, int nplayers)
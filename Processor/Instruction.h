@@ -120,6 +120,7 @@ enum
     APPLYSHUFFLE = 0xFC,
     DELSHUFFLE = 0xFD,
     INVPERM = 0xFE,
+    RADIXSORT = 0xFF,
     // Data access
     TRIPLE = 0x50,
     BIT = 0x51,
@@ -356,6 +357,7 @@ public:
   int get_r(int i) const { return r[i]; }
   size_t get_n() const { return n; }
   const vector<int>& get_start() const { return start; }
+  const string& get_str() const { return str; }
   int get_opcode() const { return opcode; }
   int get_size() const { return size; }
 
@@ -284,7 +284,6 @@ void BaseInstruction::parse_operands(istream& s, int pos, int file_pos)
       // instructions with 5 register operands
       case PRINTFLOATPLAIN:
       case PRINTFLOATPLAINB:
-      case APPLYSHUFFLE:
         get_vector(5, start, s);
         break;
       case INCINT:
@@ -319,6 +318,7 @@ void BaseInstruction::parse_operands(istream& s, int pos, int file_pos)
       case RUN_TAPE:
       case CONV2DS:
       case MATMULS:
+      case APPLYSHUFFLE:
         num_var_args = get_int(s);
         get_vector(num_var_args, start, s);
         break;
@@ -326,6 +326,10 @@ void BaseInstruction::parse_operands(istream& s, int pos, int file_pos)
         get_ints(r, s, 3);
         get_vector(9, start, s);
         break;
+      case RADIXSORT:
+        get_ints(r, s, 2);
+        get_vector(3, start, s);
+        break;
 
       // read from file, input is opcode num_args, 
       //   start_file_posn (read), end_file_posn(write) var1, var2, ...
@@ -479,6 +483,12 @@ void BaseInstruction::parse_operands(istream& s, int pos, int file_pos)
       case REVEAL:
         get_vector(get_int(s), start, s);
         break;
+      case CIRCUIT:
+        num_var_args = get_int(s) - 2;
+        get_string(str, s);
+        n = get_int(s);
+        get_vector(num_var_args, start, s);
+        break;
       case PRINTREGSIGNED:
       case INTOUTPUT:
         n = get_int(s);
@@ -588,6 +598,7 @@ int BaseInstruction::get_reg_type() const
     case ACCEPTCLIENTCONNECTION:
     case GENSECSHUFFLE:
     case CMDLINEARG:
+    case RADIXSORT:
       return INT;
     case PREP:
     case GPREP:
@@ -738,6 +749,22 @@ unsigned BaseInstruction::get_max_reg(int reg_type) const
   }
   case MATMULSM:
       return r[0] + start[0] * start[2];
+  case RADIXSORT:
+      return max(r[0], r[1]) + 1;
+  case CIRCUIT:
+  {
+      unsigned res = 0;
+      for (size_t i = 1; i < start.size(); i++)
+          res = max(res, unsigned(start[i] + DIV_CEIL(n, 64)));
+      return res;
+  }
+  case APPLYSHUFFLE:
+  {
+      unsigned res = 0;
+      for (size_t i = 0; i < start.size(); i += 6)
+          res = max(res, unsigned(max(start[i + 1], start[i + 2]) + start[i]));
+      return res;
+  }
   case CONV2DS:
   {
       unsigned res = 0;
@@ -1137,8 +1164,7 @@ inline void Instruction::execute(Processor<sint, sgf2n>& Proc) const
             Proc.machine.shuffle_store));
         return;
       case APPLYSHUFFLE:
-        Proc.Procp.apply_shuffle(*this, Proc.read_Ci(start.at(3)),
-            Proc.machine.shuffle_store);
+        Proc.Procp.apply_shuffle(start, Proc.machine.shuffle_store);
         return;
       case DELSHUFFLE:
         Proc.machine.shuffle_store.del(Proc.read_Ci(r[0]));
@@ -1146,6 +1172,10 @@ inline void Instruction::execute(Processor<sint, sgf2n>& Proc) const
       case INVPERM:
         Proc.Procp.inverse_permutation(*this);
         return;
+      case RADIXSORT:
+        Proc.Procp.radix_sort(*this, Proc.machine.Mp.MS, Proc.read_Ci(r[0]),
+            Proc.read_Ci(r[1]));
+        return;
       case CHECK:
         {
           CheckJob job;
@@ -10,6 +10,7 @@
 using namespace std;
 
 template<class sint, class sgf2n> class Machine;
+template<class T> class PrepWorker;
 
 template<class sint, class sgf2n>
 class thread_info
@@ -32,6 +33,9 @@ class thread_info
   static void print_usage(ostream& o, const vector<T>& regs,
       const char* name);
 
+  PrepWorker<sint>* start_prep_worker(Processor<sint, sgf2n>& Proc, true_type);
+  PrepWorker<sint>* start_prep_worker(Processor<sint, sgf2n>& Proc, false_type);
+
   void Sub_Main_Func();
 };
 
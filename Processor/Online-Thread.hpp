@@ -8,6 +8,7 @@
 #include "Networking/CryptoPlayer.h"
 #include "Protocols/ShuffleSacrifice.h"
 #include "Protocols/LimitedPrep.h"
+#include "Protocols/Rep3Shuffler.h"
 #include "FHE/FFT.h"
 
 #include "Processor/Processor.hpp"
@@ -30,6 +31,30 @@ void thread_info<sint, sgf2n>::print_usage(ostream &o,
   ::print_usage(o, name, regs.capacity());
 }
 
+template<class sint, class sgf2n>
+PrepWorker<sint>* thread_info<sint, sgf2n>::start_prep_worker(
+    Processor<sint, sgf2n>& Proc, true_type)
+{
+  auto prep = dynamic_cast<BufferPrep<sint>*>(&Proc.DataF.DataFp);
+  if (not prep)
+    return 0;
+
+  auto res = new PrepWorker<sint>(*Nms, thread_num,
+      Proc.MCp.get_alphai(), machine->use_encryption);
+  prep->set_worker(res);
+  return res;
+}
+
+template<class sint, class sgf2n>
+PrepWorker<sint>* thread_info<sint, sgf2n>::start_prep_worker(
+    Processor<sint, sgf2n>&, false_type)
+{
+  if (thread_num == 0)
+    cerr << "Background preprocessing not implemented for "
+        << sint::type_string() << ", ignoring --async-preprocessing" << endl;
+  return 0;
+}
+
 template<class sint, class sgf2n>
 void thread_info<sint, sgf2n>::Sub_Main_Func()
 {
@@ -102,6 +127,11 @@ void thread_info<sint, sgf2n>::Sub_Main_Func()
   processor = new Processor<sint, sgf2n>(tinfo->thread_num,P,*MC2,*MCp,machine,progs.at(thread_num > 0));
   auto& Proc = *processor;
 
+  PrepWorker<sint>* prep_worker = 0;
+  if (machine.live_prep and opts.async_prep)
+    prep_worker = start_prep_worker(Proc,
+        integral_constant<bool, sint::background_prep>());
+
   // don't count communication for initialization
   P.reset_stats();
 
@@ -261,6 +291,12 @@ void thread_info<sint, sgf2n>::Sub_Main_Func()
           matrix_rand_mult(job, sint::triple_matmul);
           queues->finished(job);
         }
+      else if (job.type == RESHARE_JOB)
+        {
+          Rep3Resharing<sint>::run_job(job, Proc.Procp,
+              is_same<typename sint::Protocol::Shuffler, Rep3Shuffler<sint>>());
+          queues->finished(job);
+        }
       else
         { // RUN PROGRAM
 #ifdef DEBUG_THREADS
@@ -274,6 +310,7 @@ void thread_info<sint, sgf2n>::Sub_Main_Func()
           Proc.DataF.seekg(job.pos);
           // reset for actual usage
           Proc.DataF.reset_usage();
+          BaseMachine::start_tape(program, &Proc.DataF.current_usage());
              
           //printf("\tExecuting program");
           // Execute the program
@@ -286,6 +323,7 @@ void thread_info<sint, sgf2n>::Sub_Main_Func()
           cout.flush();
 
           actual_usage.increase(Proc.DataF.get_usage());
+          BaseMachine::finish_tape(Proc.DataF.get_usage());
 
          if (progs[program].usage_unknown())
            { // communicate file positions to main thread
@@ -347,11 +385,19 @@ void thread_info<sint, sgf2n>::Sub_Main_Func()
   queues->timers["online"] = online_timer - online_prep_timer - queues->wait_timer;
   queues->timers["prep"] = timer - queues->timers["wait"] - queues->timers["online"];
 
+  NamedCommStats comm = P.total_comm();
+  if (prep_worker)
+    {
+      prep_worker->stop();
+      comm += prep_worker->comm_stats;
+      delete prep_worker;
+    }
+
   // prevent faulty usage message
   Proc.DataF.set_usage(actual_usage);
   delete processor;
 
-  queues->finished(actual_usage, P.total_comm());
+  queues->finished(actual_usage, comm);
 
   delete MC2;
   delete MCp;
@@ -23,9 +23,15 @@ OnlineOptions::OnlineOptions() : playerno(-1)
     lgp = gfp0::MAX_N_BITS;
     live_prep = true;
     batch_size = 1000;
+    adaptive_batch = 0;
+    async_prep = false;
     memtype = "empty";
     bits_from_squares = false;
     direct = false;
+    all_reduce = "auto";
+    pipeline = false;
+    hash_chain_check = false;
+    merge_ands = true;
     bucket_size = 4;
     security_parameter = DEFAULT_SECURITY;
     use_security_parameter = false;
@@ -36,6 +42,8 @@ OnlineOptions::OnlineOptions() : playerno(-1)
     opening_sum = 0;
     max_broadcast = 0;
     receive_threads = false;
+    ot_threads = 1;
+    soft_spoken_bits = 2;
 #ifdef VERBOSE
     verbose = true;
 #else
@@ -113,6 +121,17 @@ OnlineOptions::OnlineOptions(ez::ezOptionParser& opt, int argc,
             "--bucket-size" // Flag token.
     );
 
+    opt.add(
+            "", // Default.
+            0, // Required?
+            0, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Execute AND instructions in binary circuits one by one "
+            "instead of merging independent ones", // Help description.
+            "-nam", // Flag token.
+            "--no-and-merging" // Flag token.
+    );
+
     if (security)
         opt.add(
             to_string(security_parameter).c_str(), // Default.
@@ -133,6 +152,7 @@ OnlineOptions::OnlineOptions(ez::ezOptionParser& opt, int argc,
     opt.get("-OF")->getString(cmd_private_output_file);
 
     opt.get("--bucket-size")->getInt(bucket_size);
+    merge_ands = not opt.isSet("--no-and-merging");
 
 #ifndef VERBOSE
     verbose = opt.isSet("--verbose");
@@ -222,6 +242,27 @@ OnlineOptions::OnlineOptions(ez::ezOptionParser& opt, int argc,
             "-b", // Flag token.
             "--batch-size" // Flag token.
     );
+    opt.add(
+            "0", // Default.
+            0, // Required?
+            1, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Size preprocessing batches from the consumption of the "
+            "last run of the same tape in the same thread, up to the given "
+            "memory cap in MB per type (default: 0, i.e., fixed batch size)", // Help description.
+            "-ab", // Flag token.
+            "--adaptive-batch" // Flag token.
+    );
+    opt.add(
+            "", // Default.
+            0, // Required?
+            0, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Generate triples and bits in a separate thread with "
+            "separate connections during live preprocessing", // Help description.
+            "-ap", // Flag token.
+            "--async-preprocessing" // Flag token.
+    );
     opt.add(
             memtype.c_str(), // Default.
             0, // Required?
@@ -252,6 +293,43 @@ OnlineOptions::OnlineOptions(ez::ezOptionParser& opt, int argc,
             "-d", // Flag token.
             "--direct" // Flag token.
     );
+    opt.add(
+            all_reduce.c_str(), // Default.
+            0, // Required?
+            1, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Schedule for summing and broadcasting openings, "
+            "auto|off|butterfly|ring (default: auto)\n\t"
+            "auto: choose by number of parties and values\n\t"
+            "off: only use the tree (or direct reconstruction for Shamir)\n\t"
+            "butterfly: recursive doubling\n\t"
+            "ring: reduce-scatter followed by all-gather", // Help description.
+            "-ar", // Flag token.
+            "--all-reduce" // Flag token.
+    );
+    opt.add(
+            "", // Default.
+            0, // Required?
+            0, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Overlap batches of large multiplication rounds "
+            "(replicated, Shamir, and direct semi-honest). This relies on "
+            "the socket buffers holding two batches of 32 KB per "
+            "connection", // Help description.
+            "-pl", // Flag token.
+            "--pipeline" // Flag token.
+    );
+    opt.add(
+            "", // Default.
+            0, // Required?
+            0, // Number of args expected.
+            0, // Delimiter if expecting multiple args.
+            "Derive MAC check coefficients from a hash chain over the "
+            "opened values instead of a fresh joint seed per check "
+            "(only for coefficients of at least 128 bits)", // Help description.
+            "-hc", // Flag token.
+            "--hash-chain-check" // Flag token.
+    );
 
     opt.parse(argc, argv);
 
@@ -273,11 +351,24 @@ OnlineOptions::OnlineOptions(ez::ezOptionParser& opt, int argc,
         file_prep_per_thread = true;
     }
     opt.get("-b")->getInt(batch_size);
+    opt.get("--adaptive-batch")->getInt(adaptive_batch);
+    async_prep = opt.isSet("--async-preprocessing");
     opt.get("--memory")->getString(memtype);
     bits_from_squares = opt.isSet("-Q");
 
     direct = opt.isSet("--direct");
 
+    opt.get("--all-reduce")->getString(all_reduce);
+    if (all_reduce != "auto" and all_reduce != "off"
+            and all_reduce != "butterfly" and all_reduce != "ring")
+    {
+        cerr << "Unknown all-reduce schedule: " << all_reduce << endl;
+        exit(1);
+    }
+
+    pipeline = opt.isSet("--pipeline");
+    hash_chain_check = opt.isSet("--hash-chain-check");
+
     opt.resetArgs();
 }
 
@@ -395,6 +486,43 @@ void OnlineOptions::finalize(ez::ezOptionParser& opt, int argc,
 
     receive_threads = opt.isSet("--threads");
 
+    o = opt.get("--ot-threads");
+    if (o)
+        o->getInt(ot_threads);
+    if (ot_threads < 1)
+    {
+        cerr << "Need at least one thread for OT extension" << endl;
+        exit(1);
+    }
+#ifdef USE_KOS
+    // only SoftSpokenOT extension is split
+    if (ot_threads > 1)
+    {
+        cerr << "OT extension uses one thread per pair of parties "
+                "with USE_KOS, ignoring --ot-threads" << endl;
+        ot_threads = 1;
+    }
+#endif
+
+    o = opt.get("--soft-spoken");
+    if (o)
+        o->getInt(soft_spoken_bits);
+    // whole number of subspaces in 128 base OTs
+    if (soft_spoken_bits != 2 and soft_spoken_bits != 4
+            and soft_spoken_bits != 8)
+    {
+        cerr << "SoftSpokenOT field size must be 2, 4, or 8 bits" << endl;
+        exit(1);
+    }
+#ifdef USE_KOS
+    if (soft_spoken_bits != 2)
+    {
+        cerr << "OT extension is KOS with USE_KOS, ignoring --soft-spoken"
+                << endl;
+        soft_spoken_bits = 2;
+    }
+#endif
+
     if (use_security_parameter)
     {
         int program_sec = BaseMachine::security_from_schedule(progname);
@@ -22,6 +22,8 @@ public:
     int playerno;
     std::string progname;
     int batch_size;
+    int adaptive_batch;
+    bool async_prep;
     std::string memtype;
     bool bits_from_squares;
     bool direct;
@@ -34,7 +36,13 @@ public:
     bool file_prep_per_thread;
     int trunc_error;
     int opening_sum, max_broadcast;
+    std::string all_reduce;
+    bool pipeline;
+    bool hash_chain_check;
+    bool merge_ands;
     bool receive_threads;
+    int ot_threads;
+    int soft_spoken_bits;
     std::string disk_memory;
     vector<long> args;
 
@@ -55,6 +55,27 @@ OnlineOptions::OnlineOptions(ez::ezOptionParser& opt, int argc,
               "-mb", // Flag token.
               "--max-broadcast" // Flag token.
         );
+        opt.add(
+              "1", // Default.
+              0, // Required?
+              1, // Number of args expected.
+              0, // Delimiter if expecting multiple args.
+              "Number of threads per pair of parties for OT extension "
+              "in live preprocessing, not with USE_KOS (default: 1)", // Help description.
+              "-ot", // Flag token.
+              "--ot-threads" // Flag token.
+        );
+        opt.add(
+              "2", // Default.
+              0, // Required?
+              1, // Number of args expected.
+              0, // Delimiter if expecting multiple args.
+              "Field size in bits for SoftSpokenOT (2, 4, or 8). Larger "
+              "sizes send less for OT extension but compute more, "
+              "not with USE_KOS (default: 2)", // Help description.
+              "-ss", // Flag token.
+              "--soft-spoken" // Flag token.
+        );
     }
 
     if (not T::clear::binary)
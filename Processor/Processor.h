@@ -21,6 +21,7 @@
 #include "GC/Processor.h"
 #include "GC/ShareThread.h"
 #include "Protocols/SecureShuffle.h"
+#include "ShareBatch.h"
 
 class Program;
 
@@ -41,6 +42,10 @@ class SubProcessor
   void matmulsm_finalize(int i, int j, const vector<int>& dim,
       typename vector<T>::iterator C);
 
+  void pipelined_muls(const vector<array<int, 3>>& args);
+
+  void reveal_destinations(vector<int>& res, const T* source);
+
   template<class sint, class sgf2n> friend class Processor;
   template<class U> friend class SPDZ;
   template<class U> friend class ProtocolBase;
@@ -62,6 +67,8 @@ public:
   typename BT::LivePrep bit_prep;
   vector<typename BT::LivePrep*> personal_bit_preps;
 
+  BatchedOperations<T> batched;
+
   SubProcessor(ArithmeticProcessor& Proc, typename T::MAC_Check& MC,
       Preprocessing<T>& DataF, Player& P);
   SubProcessor(typename T::MAC_Check& MC, Preprocessing<T>& DataF, Player& P,
@@ -84,9 +91,10 @@ public:
   void secure_shuffle(const Instruction& instruction);
   size_t generate_secure_shuffle(const Instruction& instruction,
       ShuffleStore& shuffle_store);
-  void apply_shuffle(const Instruction& instruction, int handle,
-          ShuffleStore& shuffle_store);
+  void apply_shuffle(const vector<int>& args, ShuffleStore& shuffle_store);
   void inverse_permutation(const Instruction& instruction);
+  void radix_sort(const Instruction& instruction, MemoryPart<T>& memory,
+      size_t bits_base, size_t data_base);
 
   void input_personal(const vector<int>& args);
   void send_personal(const vector<int>& args);
@@ -6,6 +6,7 @@
 #include "GC/square64.h"
 #include "SpecificPrivateOutput.h"
 #include "Conv2dTuple.h"
+#include "ShareBatch.hpp"
 
 #include "Processor/ProcessorBase.hpp"
 #include "GC/Processor.hpp"
@@ -187,17 +188,8 @@ template<class sint, class sgf2n>
 void Processor<sint, sgf2n>::dabit(const Instruction& instruction)
 {
   int size = instruction.get_size();
-  int unit = sint::bit_type::default_length;
-  for (int i = 0; i < DIV_CEIL(size, unit); i++)
-  {
-    Procb.S[instruction.get_r(1) + i] = {};
-  }
-  for (int i = 0; i < size; i++)
-  {
-    typename sint::bit_type tmp;
-    Procp.DataF.get_dabit(Procp.get_S_ref(instruction.get_r(0) + i), tmp);
-    Procb.S[instruction.get_r(1) + i / unit] ^= tmp << (i % unit);
-  }
+  Procp.DataF.get_dabits(size, &Procp.get_S_ref(instruction.get_r(0)),
+      Procb.S, instruction.get_r(1));
 }
 
 template<class sint, class sgf2n>
@@ -483,6 +475,24 @@ void SubProcessor<T>::muls(const vector<int>& reg)
     int n = reg.size() / 4;
 
     SubProcessor<T>& proc = *this;
+
+    size_t n_mults = 0;
+    for (int i = 0; i < n; i++)
+        n_mults += reg[4 * i];
+    if (protocol.pipelines(n_mults))
+    {
+        vector<array<int, 3>> args;
+        args.reserve(n_mults);
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < reg[4 * i]; j++)
+                args.push_back({{reg[4 * i + 1] + j, reg[4 * i + 2] + j,
+                        reg[4 * i + 3] + j}});
+        pipelined_muls(args);
+        for (int i = 0; i < n; i++)
+            protocol.counter += n * reg[4 * i];
+        return;
+    }
+
     protocol.init_mul();
     for (int i = 0; i < n; i++)
         for (int j = 0; j < reg[4 * i]; j++)
@@ -502,6 +512,18 @@ void SubProcessor<T>::muls(const vector<int>& reg)
     }
 }
 
+template<class T>
+void SubProcessor<T>::pipelined_muls(const vector<array<int, 3>>& args)
+{
+    protocol.pipeline(args.size(), [&](size_t i)
+    {
+        protocol.prepare_mul(S[args[i][1]], S[args[i][2]]);
+    }, [&](size_t i)
+    {
+        S[args[i][0]] = protocol.finalize_mul();
+    });
+}
+
 template<class T>
 void SubProcessor<T>::mulrs(const vector<int>& reg)
 {
@@ -509,6 +531,24 @@ void SubProcessor<T>::mulrs(const vector<int>& reg)
     int n = reg.size() / 4;
 
     SubProcessor<T>& proc = *this;
+
+    size_t n_mults = 0;
+    for (int i = 0; i < n; i++)
+        n_mults += reg[4 * i];
+    if (protocol.pipelines(n_mults))
+    {
+        vector<array<int, 3>> args;
+        args.reserve(n_mults);
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < reg[4 * i]; j++)
+                args.push_back({{reg[4 * i + 1] + j, reg[4 * i + 2] + j,
+                        reg[4 * i + 3]}});
+        pipelined_muls(args);
+        for (int i = 0; i < n; i++)
+            protocol.counter += reg[4 * i];
+        return;
+    }
+
     protocol.init_mul();
     for (int i = 0; i < n; i++)
         for (int j = 0; j < reg[4 * i]; j++)
@@ -807,13 +847,14 @@ size_t SubProcessor<T>::generate_secure_shuffle(const Instruction& instruction,
 }
 
 template<class T>
-void SubProcessor<T>::apply_shuffle(const Instruction& instruction, int handle,
+void SubProcessor<T>::apply_shuffle(const vector<int>& args,
     ShuffleStore& shuffle_store)
 {
-    shuffler.apply(S, instruction.get_size(), instruction.get_start()[2],
-            instruction.get_start()[0], instruction.get_start()[1],
-            shuffle_store.get(handle),
-            instruction.get_start()[4]);
+    assert(args.size() % 6 == 0);
+    vector<typename T::Protocol::Shuffler::shuffle_type*> shuffles;
+    for (size_t i = 0; i < args.size(); i += 6)
+        shuffles.push_back(&shuffle_store.get(Proc->read_Ci(args[i + 4])));
+    shuffler.apply_multiple(S, args, shuffles);
 }
 
 template<class T>
@@ -822,6 +863,126 @@ void SubProcessor<T>::inverse_permutation(const Instruction& instruction) {
                                  instruction.get_start()[1]);
 }
 
+template<class T>
+void SubProcessor<T>::reveal_destinations(vector<int>& res, const T* source)
+{
+    size_t n = res.size();
+    MC.init_open(P, n);
+    for (size_t j = 0; j < n; j++)
+        MC.prepare_open(source[j]);
+    MC.exchange(P);
+    for (size_t j = 0; j < n; j++)
+    {
+        auto dest = Integer::convert_unsigned(MC.finalize_open()).get();
+        if (dest < 0 or size_t(dest) >= n)
+            throw runtime_error("invalid destination in sorting");
+        res[j] = dest;
+    }
+
+    if (Proc != 0)
+    {
+        Proc->sent += n;
+        Proc->rounds++;
+    }
+}
+
+/**
+ * Radix sort as in ``Compiler.sorting.radix_sort_from_matrix``
+ * with all passes in one instruction. The bits are stored
+ * least significant first, one row of ``n`` per bit, and the
+ * rows of the data are of length ``unit_size``.
+ */
+template<class T>
+void SubProcessor<T>::radix_sort(const Instruction& instruction,
+        MemoryPart<T>& memory, size_t bits_base, size_t data_base)
+{
+    auto& args = instruction.get_start();
+    size_t n = args[0], n_bits = args[1], unit_size = args[2];
+    if (n < 2 or n_bits == 0)
+        return;
+    memory.check_index(bits_base + n * n_bits - 1);
+    memory.check_index(data_base + n * unit_size - 1);
+
+    // layout of the working registers: destinations, order,
+    // shuffled copies of the two, and data before and after shuffling
+    size_t c = 0, h = n, c_shuffled = 2 * n, h_shuffled = 3 * n,
+            d = 4 * n, d_shuffled = d + n * unit_size;
+    vector<T> a(d_shuffled + n * unit_size);
+    vector<T> bits(n), prefix(n);
+    vector<int> destinations(n);
+
+    int my_num = P.my_num();
+    auto alphai = MC.get_alphai();
+    for (size_t j = 0; j < n; j++)
+    {
+        a[h + j] = T::constant(j, my_num, alphai);
+        bits[j] = memory[bits_base + j];
+    }
+
+    ShuffleStore store;
+    typedef typename T::Protocol::Shuffler::shuffle_type shuffle_type;
+
+    for (size_t i = 0; i < n_bits; i++)
+    {
+        // Stable destinations for the current bit. With prefix sums p
+        // of the bits, the position of a zero is j - p_j and the
+        // position of a one is the number of zeros plus p_j - 1,
+        // which saves one multiplication per element compared to
+        // the compiled version.
+        T sum;
+        for (size_t j = 0; j < n; j++)
+        {
+            sum += bits[j];
+            prefix[j] = sum;
+        }
+        protocol.init_mul();
+        for (size_t j = 0; j < n; j++)
+            protocol.prepare_mul(bits[j],
+                    T::constant(n - j - 1, my_num, alphai) - sum + prefix[j]
+                            + prefix[j]);
+        protocol.exchange();
+        for (size_t j = 0; j < n; j++)
+            a[c + j] = protocol.finalize_mul() - prefix[j]
+                    + T::constant(j, my_num, alphai);
+        protocol.counter += n;
+
+        // move the order according to the destinations
+        int handle = shuffler.generate(n, store);
+        vector<shuffle_type*> shuffles(2, &store.get(handle));
+        shuffler.apply_multiple(a,
+                {int(n), int(c_shuffled), int(c), 1, handle, 0,
+                        int(n), int(h_shuffled), int(h), 1, handle, 0},
+                shuffles);
+        reveal_destinations(destinations, &a[c_shuffled]);
+        for (size_t j = 0; j < n; j++)
+            a[h + destinations[j]] = a[h_shuffled + j];
+        store.del(handle);
+
+        // apply the order to the next bits or the data
+        handle = shuffler.generate(n, store);
+        shuffles.assign(1, &store.get(handle));
+        shuffler.apply_multiple(a, {int(n), int(h_shuffled), int(h), 1,
+                handle, 0}, shuffles);
+        reveal_destinations(destinations, &a[h_shuffled]);
+        bool last = i == n_bits - 1;
+        size_t source_base = last ? data_base : bits_base + (i + 1) * n;
+        size_t row_size = last ? unit_size : 1;
+        for (size_t j = 0; j < n; j++)
+            for (size_t k = 0; k < row_size; k++)
+                a[d_shuffled + j * row_size + k] = memory[source_base
+                        + destinations[j] * row_size + k];
+        shuffler.apply_multiple(a, {int(n * row_size), int(d),
+                int(d_shuffled), int(row_size), handle, 1}, shuffles);
+        store.del(handle);
+
+        if (last)
+            for (size_t j = 0; j < n * unit_size; j++)
+                memory[data_base + j] = a[d + j];
+        else
+            copy(a.begin() + d, a.begin() + d + n, bits.begin());
+    }
+}
+
 template<class T>
 void SubProcessor<T>::input_personal(const vector<int>& args)
 {
@@ -0,0 +1,321 @@
+/*
+ * ShareBatch.h
+ *
+ */
+
+#ifndef PROCESSOR_SHAREBATCH_H_
+#define PROCESSOR_SHAREBATCH_H_
+
+#include "Math/gfp.h"
+#include "Math/Z2k.h"
+
+#include <vector>
+using namespace std;
+
+template<class T> class SemiShare;
+template<int K> class Semi2kShare;
+template<class T> class Share;
+template<int K, int S> class Spdz2kShare;
+template<class T> class Rep3Share;
+template<int K> class Rep3Share2;
+
+/**
+ * Limb-wise arithmetic on structure-of-arrays storage,
+ * where limb ``j`` of element ``i`` is at ``x[j * n + i]``.
+ * The primary template denotes an unsupported domain.
+ */
+template<class V>
+class BatchDomain
+{
+public:
+    static const int N_LIMBS = 0;
+};
+
+template<int X, int L>
+class BatchDomain<gfp_<X, L>>
+{
+    typedef gfp_<X, L> V;
+
+public:
+    static const int N_LIMBS = L;
+
+    static const mp_limb_t* limbs(const V& x)
+    {
+        return (const mp_limb_t*) x.get_ptr();
+    }
+
+    static void assign(V& x, const mp_limb_t* limbs)
+    {
+        auto dest = (mp_limb_t*) x.get_ptr();
+        for (int i = 0; i < L; i++)
+            dest[i] = limbs[i];
+    }
+
+    static bool has_mul();
+
+    template<class W>
+    static void mul(mp_limb_t* res, const mp_limb_t* x, const mp_limb_t* y,
+            size_t n);
+};
+
+template<class V>
+class Z2BatchDomain
+{
+public:
+    static const int N_LIMBS = (V::N_BYTES + sizeof(mp_limb_t) - 1)
+            / sizeof(mp_limb_t);
+
+    static const mp_limb_t* limbs(const V& x)
+    {
+        return x.get();
+    }
+
+    static void assign(V& x, const mp_limb_t* limbs)
+    {
+        auto dest = (mp_limb_t*) x.get_ptr();
+        for (int i = 0; i < N_LIMBS; i++)
+            dest[i] = limbs[i];
+    }
+
+    static bool has_mul()
+    {
+        // single limbs are vectorized per element already
+        return N_LIMBS > 1;
+    }
+
+    template<class W>
+    static void mul(mp_limb_t* res, const mp_limb_t* x, const mp_limb_t* y,
+            size_t n);
+};
+
+template<int K>
+class BatchDomain<Z2<K>> : public Z2BatchDomain<Z2<K>>
+{
+};
+
+template<int K>
+class BatchDomain<SignedZ2<K>> : public Z2BatchDomain<SignedZ2<K>>
+{
+};
+
+/**
+ * Decomposition of a share or clear type into components
+ * in the same domain (e.g., value and MAC).
+ * The primary template denotes an unsupported type.
+ */
+template<class T>
+class BatchLayout
+{
+public:
+    typedef void domain_type;
+    static const int N_COMPONENTS = 0;
+};
+
+template<class T, class U>
+class ValueBatchLayout
+{
+public:
+    typedef U domain_type;
+    static const int N_COMPONENTS = 1;
+
+    static const U& get(const T& x, int)
+    {
+        return x;
+    }
+
+    static void set(T& x, int, const U& value)
+    {
+        static_cast<U&>(x) = value;
+    }
+};
+
+template<class T, class U>
+class MacBatchLayout
+{
+public:
+    typedef U domain_type;
+    static const int N_COMPONENTS = 2;
+
+    static const U& get(const T& x, int i)
+    {
+        if (i == 0)
+            return x.get_share();
+        else
+            return x.get_mac();
+    }
+
+    static void set(T& x, int i, const U& value)
+    {
+        if (i == 0)
+            x.set_share(value);
+        else
+            x.set_mac(value);
+    }
+};
+
+template<class T, class U>
+class ReplicatedBatchLayout
+{
+public:
+    typedef U domain_type;
+    static const int N_COMPONENTS = 2;
+
+    static const U& get(const T& x, int i)
+    {
+        return x[i];
+    }
+
+    static void set(T& x, int i, const U& value)
+    {
+        x[i] = value;
+    }
+};
+
+template<int X, int L>
+class BatchLayout<gfp_<X, L>> : public ValueBatchLayout<gfp_<X, L>, gfp_<X, L>>
+{
+};
+
+template<int K>
+class BatchLayout<Z2<K>> : public ValueBatchLayout<Z2<K>, Z2<K>>
+{
+};
+
+template<int K>
+class BatchLayout<SignedZ2<K>> : public ValueBatchLayout<SignedZ2<K>,
+        SignedZ2<K>>
+{
+};
+
+template<int X, int L>
+class BatchLayout<SemiShare<gfp_<X, L>>> : public ValueBatchLayout<
+        SemiShare<gfp_<X, L>>, gfp_<X, L>>
+{
+};
+
+template<int K>
+class BatchLayout<Semi2kShare<K>> : public ValueBatchLayout<Semi2kShare<K>,
+        SignedZ2<K>>
+{
+};
+
+template<int X, int L>
+class BatchLayout<Share<gfp_<X, L>>> : public MacBatchLayout<Share<gfp_<X, L>>,
+        gfp_<X, L>>
+{
+};
+
+template<int K, int S>
+class BatchLayout<Spdz2kShare<K, S>> : public MacBatchLayout<Spdz2kShare<K, S>,
+        Z2<K + S>>
+{
+};
+
+template<int X, int L>
+class BatchLayout<Rep3Share<gfp_<X, L>>> : public ReplicatedBatchLayout<
+        Rep3Share<gfp_<X, L>>, gfp_<X, L>>
+{
+};
+
+template<int K>
+class BatchLayout<Rep3Share2<K>> : public ReplicatedBatchLayout<Rep3Share2<K>,
+        Z2<K>>
+{
+};
+
+/**
+ * Structure-of-arrays storage of shares or clear values:
+ * every limb of every component (such as the value and the MAC)
+ * is stored contiguously for all elements,
+ * which allows branch-free kernels that the compiler can vectorize.
+ */
+template<class T>
+class ShareBatch
+{
+    typedef BatchLayout<T> Layout;
+
+public:
+    typedef typename Layout::domain_type domain_type;
+    typedef BatchDomain<domain_type> Domain;
+
+    static const int N_COMPONENTS = Layout::N_COMPONENTS;
+    static const int N_LIMBS = Domain::N_LIMBS;
+
+    static const bool supported = N_COMPONENTS > 0 and N_LIMBS > 0;
+
+private:
+    size_t n;
+    vector<mp_limb_t> limbs;
+
+public:
+    ShareBatch(size_t n = 0)
+    {
+        resize(n);
+    }
+
+    void resize(size_t n)
+    {
+        this->n = n;
+        limbs.resize(N_COMPONENTS * N_LIMBS * n);
+    }
+
+    size_t size() const
+    {
+        return n;
+    }
+
+    mp_limb_t* component(int i)
+    {
+        return limbs.data() + i * N_LIMBS * n;
+    }
+
+    const mp_limb_t* component(int i) const
+    {
+        return limbs.data() + i * N_LIMBS * n;
+    }
+
+    void load(const T* source);
+    void store(T* dest) const;
+
+    /// Multiply every component by a batch of clear values
+    template<class U>
+    void mul(const ShareBatch& x, const ShareBatch<U>& y);
+};
+
+/**
+ * Multiplication of register vectors by clear values (MULM).
+ * This runs in chunks of structure-of-arrays batches where supported
+ * because per-element multiplication is dominated by dispatch and branching.
+ * Other instructions are not batched because conversion would cost more
+ * than it saves, see Utils/share-batch-test.cpp for a test.
+ */
+template<class T, bool = ShareBatch<T>::supported>
+class BatchedOperations
+{
+public:
+    void mul(T* res, const T* x, const typename T::clear* y, size_t n)
+    {
+        for (size_t i = 0; i < n; i++)
+            res[i] = x[i] * y[i];
+    }
+};
+
+template<class T>
+class BatchedOperations<T, true> : public BatchedOperations<T, false>
+{
+    typedef BatchedOperations<T, false> super;
+    typedef typename T::clear clear;
+
+    ShareBatch<T> batches[2];
+    ShareBatch<clear> clear_batch;
+
+public:
+    // small enough to stay in L1 cache, not a multiple of the page size
+    static const size_t CHUNK_SIZE = 250;
+    // below this, conversion costs more than it saves
+    static const size_t MIN_SIZE = 16;
+
+    void mul(T* res, const T* x, const clear* y, size_t n);
+};
+
+#endif /* PROCESSOR_SHAREBATCH_H_ */
@@ -0,0 +1,184 @@
+/*
+ * ShareBatch.hpp
+ *
+ */
+
+#ifndef PROCESSOR_SHAREBATCH_HPP_
+#define PROCESSOR_SHAREBATCH_HPP_
+
+#include "ShareBatch.h"
+
+#include <type_traits>
+
+template<int X, int L>
+bool BatchDomain<gfp_<X, L>>::has_mul()
+{
+    auto& ZpD = V::get_ZpD();
+    return ZpD.get_mont() and ZpD.get_t() == L;
+}
+
+template<int X, int L>
+template<class W>
+void BatchDomain<gfp_<X, L>>::mul(mp_limb_t* res, const mp_limb_t* x,
+        const mp_limb_t* y, size_t n)
+{
+    static_assert(is_same<W, V>::value, "multiplication within field only");
+    assert(has_mul());
+    auto& ZpD = V::get_ZpD();
+    mp_limb_t p[L], pi = ZpD.get_pi();
+    inline_mpn_copyi(p, ZpD.get_prA(), L);
+
+    // Montgomery multiplication with coarsely integrated operand scanning
+    for (size_t i = 0; i < n; i++)
+    {
+        mp_limb_t xx[L], yy[L], acc[L + 2] = {};
+        for (int j = 0; j < L; j++)
+        {
+            xx[j] = x[j * n + i];
+            yy[j] = y[j * n + i];
+        }
+
+        for (int j = 0; j < L; j++)
+        {
+            __uint128_t t;
+            mp_limb_t carry = 0;
+            for (int k = 0; k < L; k++)
+            {
+                t = __uint128_t(xx[j]) * yy[k] + acc[k] + carry;
+                acc[k] = t;
+                carry = t >> 64;
+            }
+            t = __uint128_t(acc[L]) + carry;
+            acc[L] = t;
+            acc[L + 1] = t >> 64;
+
+            mp_limb_t u = acc[0] * pi;
+            t = __uint128_t(u) * p[0] + acc[0];
+            carry = t >> 64;
+            for (int k = 1; k < L; k++)
+            {
+                t = __uint128_t(u) * p[k] + acc[k] + carry;
+                acc[k - 1] = t;
+                carry = t >> 64;
+            }
+            t = __uint128_t(acc[L]) + carry;
+            acc[L - 1] = t;
+            acc[L] = acc[L + 1] + mp_limb_t(t >> 64);
+        }
+
+        // final subtraction if the result is at least the prime
+        mp_limb_t diff[L], borrow = 0;
+        for (int j = 0; j < L; j++)
+        {
+            mp_limb_t b = acc[j] - p[j];
+            mp_limb_t next_borrow = (acc[j] < p[j]) | (b < borrow);
+            diff[j] = b - borrow;
+            borrow = next_borrow;
+        }
+        mp_limb_t keep = -(borrow & (acc[L] == 0));
+        for (int j = 0; j < L; j++)
+            res[j * n + i] = (acc[j] & keep) | (diff[j] & ~keep);
+    }
+}
+
+template<class V>
+template<class W>
+void Z2BatchDomain<V>::mul(mp_limb_t* res, const mp_limb_t* x,
+        const mp_limb_t* y, size_t n)
+{
+    // clear values may be shorter and are zero-extended
+    const int M = BatchDomain<W>::N_LIMBS;
+    static_assert(M <= N_LIMBS, "clear value too long");
+
+    if (N_LIMBS == 1)
+    {
+        for (size_t i = 0; i < n; i++)
+            res[i] = (x[i] * y[i]) & V::UPPER_MASK;
+        return;
+    }
+
+    for (size_t i = 0; i < n; i++)
+    {
+        mp_limb_t acc[N_LIMBS] = {};
+        for (int j = 0; j < M; j++)
+        {
+            mp_limb_t yy = y[j * n + i], carry = 0;
+            for (int k = 0; k < N_LIMBS - j; k++)
+            {
+                __uint128_t t = __uint128_t(x[k * n + i]) * yy + acc[j + k]
+                        + carry;
+                acc[j + k] = t;
+                carry = t >> 64;
+            }
+        }
+        for (int j = 0; j < N_LIMBS; j++)
+            res[j * n + i] = acc[j];
+        res[(N_LIMBS - 1) * n + i] &= V::UPPER_MASK;
+    }
+}
+
+template<class T>
+void ShareBatch<T>::load(const T* source)
+{
+    for (int c = 0; c < N_COMPONENTS; c++)
+    {
+        auto dest = component(c);
+        for (size_t i = 0; i < n; i++)
+        {
+            auto x = Domain::limbs(Layout::get(source[i], c));
+            for (int j = 0; j < N_LIMBS; j++)
+                dest[j * n + i] = x[j];
+        }
+    }
+}
+
+template<class T>
+void ShareBatch<T>::store(T* dest) const
+{
+    for (int c = 0; c < N_COMPONENTS; c++)
+    {
+        auto source = component(c);
+        for (size_t i = 0; i < n; i++)
+        {
+            mp_limb_t x[N_LIMBS];
+            for (int j = 0; j < N_LIMBS; j++)
+                x[j] = source[j * n + i];
+            domain_type value;
+            Domain::assign(value, x);
+            Layout::set(dest[i], c, value);
+        }
+    }
+}
+
+template<class T>
+template<class U>
+void ShareBatch<T>::mul(const ShareBatch& x, const ShareBatch<U>& y)
+{
+    static_assert(ShareBatch<U>::N_COMPONENTS == 1, "need clear values");
+    assert(x.size() == n and y.size() == n);
+    for (int c = 0; c < N_COMPONENTS; c++)
+        Domain::template mul<typename ShareBatch<U>::domain_type>(
+                component(c), x.component(c), y.component(0), n);
+}
+
+template<class T>
+void BatchedOperations<T, true>::mul(T* res, const T* x, const clear* y,
+        size_t n)
+{
+    if (n < MIN_SIZE or not ShareBatch<T>::Domain::has_mul())
+        return super::mul(res, x, y, n);
+
+    for (size_t i = 0; i < n; i += CHUNK_SIZE)
+    {
+        size_t m = min(CHUNK_SIZE, n - i);
+        batches[0].resize(m);
+        batches[1].resize(m);
+        clear_batch.resize(m);
+        batches[1].load(x + i);
+        clear_batch.load(y + i);
+        batches[0].mul(batches[1], clear_batch);
+        batches[0].store(res + i);
+    }
+}
+
+#endif /* PROCESSOR_SHAREBATCH_HPP_ */
@@ -25,6 +25,7 @@ enum ThreadJobType
     FFT_JOB,
     CIPHER_PLAIN_MULT_JOB,
     MATRX_RAND_MULT_JOB,
+    RESHARE_JOB,
     NO_JOB
 };
 
@@ -173,6 +174,16 @@ public:
     }
 };
 
+class ReshareJob : public ThreadJob
+{
+public:
+    ReshareJob(void* resharing)
+    {
+        type = RESHARE_JOB;
+        output = resharing;
+    }
+};
+
 class FftJob : public ThreadJob
 {
 public:
@@ -7,6 +7,7 @@
 #define PROTOCOLS_ATLAS_H_
 
 #include "Replicated.h"
+#include "Math/DotProduct.h"
 
 /**
  * ATLAS protocol (simple version).
@@ -28,7 +29,7 @@ class Atlas : public ProtocolBase<T>
 
     ShamirInput<T> resharing;
 
-    typename T::open_type dotprod_share;
+    DotProduct<typename T::open_type> dotprod;
 
     array<T, 2> get_double_sharing();
 
@@ -106,20 +106,19 @@ template<class T>
 void Atlas<T>::init_dotprod()
 {
     init_mul();
-    dotprod_share = 0;
+    dotprod = {};
 }
 
 template<class T>
 void Atlas<T>::prepare_dotprod(const T& x, const T& y)
 {
-    dotprod_share += x * y;
+    dotprod.add(x, y);
 }
 
 template<class T>
 void Atlas<T>::next_dotprod()
 {
-    prepare(dotprod_share);
-    dotprod_share = 0;
+    prepare(dotprod.get());
 }
 
 template<class T>
@@ -8,6 +8,7 @@
 
 #include <vector>
 #include <array>
+#include <deque>
 using namespace std;
 
 #include "Replicated.h"
@@ -30,6 +31,10 @@ protected:
     vector<int> lengths;
     typename vector<typename T::open_type>::iterator it;
     typename vector<array<T, 3>>::iterator triple;
+    deque<vector<T>> pending_shares;
+    deque<vector<typename T::open_type>> pending_opened;
+    deque<vector<array<T, 3>>> pending_triples;
+    deque<array<T, 3>> pipeline_triples;
     Preprocessing<T>* prep;
     typename T::MAC_Check* MC;
 
@@ -53,6 +58,8 @@ public:
 
     void start_exchange();
     void stop_exchange();
+    bool pipelines_exchange();
+    void start_pipeline(size_t n_mults);
 
     int get_n_relevant_players() { return 1 + T::threshold(P.num_players()); }
 
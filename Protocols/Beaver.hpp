@@ -46,7 +46,13 @@ void Beaver<T>::prepare_mul(const T& x, const T& y, int n)
     (void) n;
     triples.push_back({{}});
     auto& triple = triples.back();
-    triple = prep->get_triple(n);
+    if (pipeline_triples.empty())
+        triple = prep->get_triple(n);
+    else
+    {
+        triple = pipeline_triples.front();
+        pipeline_triples.pop_front();
+    }
     shares.push_back(x - triple[0]);
     shares.push_back(y - triple[1]);
     lengths.push_back(n);
@@ -69,17 +75,42 @@ void Beaver<T>::exchange()
 template<class T>
 void Beaver<T>::start_exchange()
 {
-    MC->POpen_Begin(opened, shares, P);
+    pending_opened.push_back({});
+    MC->POpen_Begin(pending_opened.back(), shares, P);
+    pending_shares.push_back(move(shares));
+    pending_triples.push_back(move(triples));
 }
 
 template<class T>
 void Beaver<T>::stop_exchange()
 {
-    MC->POpen_End(opened, shares, P);
+    assert(not pending_opened.empty());
+    MC->POpen_End(pending_opened.front(), pending_shares.front(), P);
+    opened = move(pending_opened.front());
+    triples = move(pending_triples.front());
+    pending_opened.pop_front();
+    pending_shares.pop_front();
+    pending_triples.pop_front();
     it = opened.begin();
     triple = triples.begin();
 }
 
+template<class T>
+bool Beaver<T>::pipelines_exchange()
+{
+    return MC and MC->pipelines_open();
+}
+
+template<class T>
+void Beaver<T>::start_pipeline(size_t n_mults)
+{
+    // generating triples in between would communicate
+    // while batches are in flight
+    assert(pipeline_triples.empty());
+    for (size_t i = 0; i < n_mults; i++)
+        pipeline_triples.push_back(prep->get_triple(-1));
+}
+
 template<class T>
 T Beaver<T>::finalize_mul(int n)
 {
@@ -6,6 +6,8 @@
 #ifndef PROTOCOLS_BUFFERSCOPE_H_
 #define PROTOCOLS_BUFFERSCOPE_H_
 
+#include <assert.h>
+
 template<class T> class BufferPrep;
 template<class T> class Preprocessing;
 
@@ -29,4 +31,27 @@ public:
     }
 };
 
+/**
+ * Buffer size for daBits or edaBits only, leaving the refills
+ * of other kinds of preprocessing as they are
+ */
+class BulkScope
+{
+    int& buffer_size;
+    int bak;
+
+public:
+    BulkScope(int& buffer_size, int bulk_size) :
+            buffer_size(buffer_size), bak(buffer_size)
+    {
+        assert(bulk_size > 0);
+        buffer_size = bulk_size;
+    }
+
+    ~BulkScope()
+    {
+        buffer_size = bak;
+    }
+};
+
 #endif /* PROTOCOLS_BUFFERSCOPE_H_ */
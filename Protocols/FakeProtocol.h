@@ -18,7 +18,8 @@ template<class T>
 class FakeShuffle
 {
 public:
-    typedef ShuffleStore<int> store_type;
+    typedef int shuffle_type;
+    typedef ShuffleStore<shuffle_type> store_type;
 
     FakeShuffle(SubProcessor<T>&)
     {
@@ -52,6 +53,13 @@ public:
         }
     }
 
+    void apply_multiple(vector<T>& a, const vector<int>& args,
+            vector<shuffle_type*>&)
+    {
+        for (size_t i = 0; i < args.size(); i += 6)
+            apply(a, args[i], args[i + 3], args[i + 1], args[i + 2], 0, 0);
+    }
+
     void inverse_permutation(vector<T>&, size_t, size_t, size_t)
     {
     }
@@ -161,7 +161,7 @@ void HemiPrep<T>::buffer_dabits(ThreadQueues* queues)
     {
         auto& prep = get_two_party_prep();
         prep.buffer_size = BaseMachine::batch_size<T>(DATA_DABIT,
-                this->buffer_size);
+                this->dabit_buffer_size());
         prep.buffer_dabits(queues);
         this->dabits = prep.dabits;
         prep.dabits.clear();
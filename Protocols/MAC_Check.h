@@ -5,6 +5,7 @@
 
 #include <vector>
 #include <deque>
+#include <algorithm>
 using namespace std;
 
 #include "Protocols/Share.h"
@@ -12,7 +13,9 @@ using namespace std;
 #include "Protocols/MAC_Check_Base.h"
 #include "Tools/time-func.h"
 #include "Tools/Coordinator.h"
+#include "Tools/Hash.h"
 #include "Processor/OnlineOptions.h"
+#include "Math/DotProduct.h"
 
 
 /* The MAX number of things we will partially open before running
@@ -26,7 +29,10 @@ using namespace std;
 
 
 /**
- * Sum and broadcast values via a tree of players
+ * Sum and broadcast values via a tree of players.
+ * With many parties or values, recursive doubling (butterfly) or
+ * reduce-scatter followed by all-gather on a ring can replace the tree,
+ * chosen by ``--all-reduce`` or automatically using a cost model.
  */
 template<class T>
 class TreeSum
@@ -39,6 +45,16 @@ class TreeSum
   void add_openings(vector<T>& values, const Player& P, int sum_players,
       int last_sum_players, int send_player);
 
+  void butterfly(vector<T>& values, const Player& P);
+  void ring(vector<T>& values, const Player& P);
+
+  void pack_values(const vector<T>& values, octetStream& os, size_t begin,
+      size_t end);
+  void unpack_values(vector<T>& values, octetStream& os, size_t begin,
+      size_t end);
+  void add_values(vector<T>& values, octetStream& os, size_t begin,
+      size_t end);
+
   virtual void post_add_process(vector<T>&) {}
 
 protected:
@@ -53,6 +69,14 @@ protected:
   virtual void AddToValues(vector<T>& values) { (void)values; }
 
 public:
+  enum schedule_type { BASELINE, BUTTERFLY, RING };
+
+  // bytes sent in the time of a round trip (about 1 ms at 1 Gbit/s)
+  static const size_t ROUND_BYTES = 1 << 17;
+
+  static schedule_type schedule(size_t n_values, int n_players,
+      int baseline_rounds, int baseline_factor);
+
   vector<octetStream> oss;
   vector<Timer> timers;
   vector<Timer> player_timers;
@@ -63,6 +87,7 @@ public:
   virtual ~TreeSum();
 
   void run(vector<T>& values, const Player& P);
+  void run(vector<T>& values, const Player& P, schedule_type schedule);
   T run(const T& value, const Player& P);
 
   octetStream& get_buffer() { return os; }
@@ -71,10 +96,23 @@ public:
 };
 
 
+/**
+ * The MAC check verifies a random linear combination of all values
+ * opened since the last check with a single commit-and-open round.
+ * By default, the values are stored until the check and combined
+ * using a fresh joint random seed, and the check runs at least every
+ * POPEN_MAX values.
+ * With ``--hash-chain-check`` and coefficients of at least 128 bits,
+ * the coefficients are instead derived from a hash chain over the
+ * opened values (seeded jointly after every check), and values are
+ * combined as soon as they are opened, which keeps the memory constant
+ * between checks.
+ */
 template<class U>
 class Tree_MAC_Check : public TreeSum<typename U::open_type>, public MAC_Check_Base<U>
 {
   typedef typename U::open_type T;
+  typedef typename U::mac_key_type::Scalar coefficient_type;
 
   template<class V> friend class Tree_MAC_Check;
 
@@ -87,10 +125,25 @@ class Tree_MAC_Check : public TreeSum<typename U::open_type>, public MAC_Check_B
   vector<typename U::mac_type> macs;
   vector<T> vals;
 
+  /* Random combination of values and MACs not yet checked */
+  DotProduct<typename U::mac_type> combined_vals, combined_macs;
+  size_t n_combined;
+  bool chain_seeded;
+  octet chain[Hash::hash_length];
+  octetStream chain_os;
+
+  static bool CombineOnOpen()
+    {
+      return OnlineOptions::singleton.hash_chain_check
+          and coefficient_type::length() >= 128;
+    }
+
   void AddToValues(vector<T>& values);
+  void AddToCombination(PRNG& G);
+  void Combine(const Player& P);
   void CheckIfNeeded(const Player& P);
   int WaitingForCheck()
-    { return max(macs.size(), vals.size()); }
+    { return max(macs.size(), vals.size()) + n_combined; }
 
   public:
 
@@ -106,7 +159,7 @@ class Tree_MAC_Check : public TreeSum<typename U::open_type>, public MAC_Check_B
   virtual void exchange(const Player& P);
 
   virtual void AddToCheck(const U& share, const T& value, const Player& P);
-  virtual void Check(const Player& P) = 0;
+  virtual void Check(const Player& P);
 
   // compatibility
   void set_random_element(const U& random_element) { (void) random_element; }
@@ -156,7 +209,6 @@ public:
   void prepare_open(const W& secret, int = -1);
   void prepare_open_no_mask(const W& secret);
 
-  virtual void Check(const Player& P);
   void set_random_element(const W& random_element);
   void set_prep(Preprocessing<W>& prep);
   virtual ~MAC_Check_Z2k() {};
@@ -217,7 +269,7 @@ public:
 
   void Check(const Player& P)
   {
-    MAC_Check_Z2k_<T>::Check(P);
+    Tree_MAC_Check<T>::Check(P);
   }
 };
 
@@ -247,14 +299,209 @@ TreeSum<T>::~TreeSum()
 #endif
 }
 
+template<class T>
+auto fixed_size(int) -> decltype(size_t(T::size()))
+{
+  return T::size();
+}
+
+template<class T>
+size_t fixed_size(long)
+{
+  // unknown or varying size
+  return 0;
+}
+
+template<class T>
+typename TreeSum<T>::schedule_type TreeSum<T>::schedule(size_t n_values,
+    int n_players, int baseline_rounds, int baseline_factor)
+{
+  auto& option = OnlineOptions::singleton.all_reduce;
+  if (option == "off" or n_players < 2)
+    return BASELINE;
+  else if (option == "butterfly")
+    return BUTTERFLY;
+  else if (option == "ring")
+    return RING;
+
+  // the choice has to be the same for all parties
+  size_t bytes = n_values * fixed_size<T>(0);
+  if (bytes == 0)
+    return BASELINE;
+
+  // latency and bytes per party on the critical path
+  size_t n = n_players;
+  size_t log = 0;
+  while ((1u << log) < n)
+    log++;
+  size_t butterfly_rounds = log + ((1u << log) != n);
+  size_t costs[] = {
+      baseline_rounds * ROUND_BYTES + baseline_factor * bytes,
+      butterfly_rounds * (ROUND_BYTES + bytes),
+      2 * (n - 1) * (ROUND_BYTES + DIV_CEIL(bytes, n)),
+  };
+  return schedule_type(min_element(costs, costs + 3) - costs);
+}
+
 template<class T>
 void TreeSum<T>::run(vector<T>& values, const Player& P)
 {
-  if (not values.empty())
+  if (values.empty())
+    return;
+
+  int n = P.num_players();
+  bool restricted = (opening_sum >= 2 and opening_sum < n)
+      or (max_broadcast >= 2 and max_broadcast < n);
+  // the star-shaped tree takes two rounds with all values at the root
+  run(values, P, restricted ? BASELINE : schedule(values.size(), n, 2, n - 1));
+}
+
+template<class T>
+void TreeSum<T>::run(vector<T>& values, const Player& P,
+    schedule_type schedule)
+{
+  if (values.empty())
+    return;
+
+  switch (schedule)
+  {
+  case BUTTERFLY:
+    butterfly(values, P);
+    break;
+  case RING:
+    ring(values, P);
+    break;
+  default:
+    start(values, P);
+    finish(values, P);
+  }
+}
+
+template<class T>
+void TreeSum<T>::pack_values(const vector<T>& values, octetStream& os,
+    size_t begin, size_t end)
+{
+  bool use_lengths = values.size() == lengths.size();
+  os.reset_write_head();
+  for (size_t i = begin; i < end; i++)
+    values[i].pack(os, use_lengths ? lengths[i] : -1);
+  os.append(0);
+}
+
+template<class T>
+void TreeSum<T>::unpack_values(vector<T>& values, octetStream& os,
+    size_t begin, size_t end)
+{
+  bool use_lengths = values.size() == lengths.size();
+  for (size_t i = begin; i < end; i++)
+    values[i].unpack(os, use_lengths ? lengths[i] : -1);
+}
+
+template<class T>
+void TreeSum<T>::add_values(vector<T>& values, octetStream& os,
+    size_t begin, size_t end)
+{
+  bool use_lengths = values.size() == lengths.size();
+  timers[SUM].start();
+  T tmp = values.at(0);
+  for (size_t i = begin; i < end; i++)
+    {
+      tmp.unpack(os, use_lengths ? lengths[i] : -1);
+      values[i] += tmp;
+    }
+  post_add_process(values);
+  timers[SUM].stop();
+}
+
+template<class T>
+void TreeSum<T>::butterfly(vector<T>& values, const Player& P)
+{
+  int n = P.num_players();
+  int me = positive_modulo(P.my_num() - base_player, n);
+  auto player = [&](int relative) { return (base_player + relative) % n; };
+  size_t size = values.size();
+  octetStream received;
+
+  int n_rounds = 0;
+  while ((2 << n_rounds) <= n)
+    n_rounds++;
+  int n_full = 1 << n_rounds;
+
+  if (me >= n_full)
+    {
+      // parties beyond the largest power of two only contribute
+      pack_values(values, os, 0, size);
+      P.send_to(player(me - n_full), os);
+      timers[RECV_SUM].start();
+      P.receive_player(player(me - n_full), os);
+      timers[RECV_SUM].stop();
+      unpack_values(values, os, 0, size);
+      AddToValues(values);
+      return;
+    }
+
+  if (me + n_full < n)
+    {
+      timers[RECV_ADD].start();
+      P.receive_player(player(me + n_full), received);
+      timers[RECV_ADD].stop();
+      add_values(values, received, 0, size);
+    }
+
+  for (int i = 0; i < n_rounds; i++)
     {
-      start(values, P);
-      finish(values, P);
+      pack_values(values, os, 0, size);
+      timers[RECV_ADD].start();
+      P.exchange(player(me ^ (1 << i)), os, received);
+      timers[RECV_ADD].stop();
+      add_values(values, received, 0, size);
     }
+
+  if (me + n_full < n)
+    {
+      pack_values(values, os, 0, size);
+      timers[BCAST].start();
+      P.send_to(player(me + n_full), os);
+      timers[BCAST].stop();
+    }
+
+  AddToValues(values);
+}
+
+template<class T>
+void TreeSum<T>::ring(vector<T>& values, const Player& P)
+{
+  int n = P.num_players();
+  int me = positive_modulo(P.my_num() - base_player, n);
+  size_t size = values.size();
+  octetStream received;
+
+  auto begin = [&](int chunk) { return size * positive_modulo(chunk, n) / n; };
+  auto end = [&](int chunk) { return size * (positive_modulo(chunk, n) + 1) / n; };
+
+  // after step i, chunk me - i - 1 contains the sum of i + 2 shares
+  for (int i = 0; i < n - 1; i++)
+    {
+      int out = me - i, in = me - i - 1;
+      pack_values(values, os, begin(out), end(out));
+      timers[RECV_ADD].start();
+      P.pass_around(os, received, 1);
+      timers[RECV_ADD].stop();
+      add_values(values, received, begin(in), end(in));
+    }
+
+  // pass on the complete sums starting with chunk me + 1
+  for (int i = 0; i < n - 1; i++)
+    {
+      int out = me + 1 - i, in = me - i;
+      pack_values(values, os, begin(out), end(out));
+      timers[RECV_SUM].start();
+      P.pass_around(os, received, 1);
+      timers[RECV_SUM].stop();
+      unpack_values(values, received, begin(in), end(in));
+    }
+
+  AddToValues(values);
 }
 
 template<class T>
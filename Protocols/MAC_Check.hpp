@@ -68,9 +68,14 @@ Tree_MAC_Check<U>::Tree_MAC_Check(const typename U::mac_key_type::Scalar& ai, in
     TreeSum<T>(opening_sum, max_broadcast, send_player)
 {
   popen_cnt=0;
+  n_combined=0;
+  chain_seeded=false;
   this->alphai=ai;
-  vals.reserve(2 * POPEN_MAX);
-  macs.reserve(2 * POPEN_MAX);
+  if (not CombineOnOpen())
+    {
+      vals.reserve(2 * POPEN_MAX);
+      macs.reserve(2 * POPEN_MAX);
+    }
 }
 
 template<class T>
@@ -125,11 +130,63 @@ void Tree_MAC_Check<U>::AddToValues(vector<T>& values)
 template<class T>
 void Tree_MAC_Check<T>::CheckIfNeeded(const Player& P)
 {
+  if (CombineOnOpen())
+    Combine(P);
   if (WaitingForCheck() >= POPEN_MAX)
     Check(P);
 }
 
 
+template<class U>
+void Tree_MAC_Check<U>::AddToCombination(PRNG& G)
+{
+  assert(int(vals.size()) >= popen_cnt);
+  assert(int(macs.size()) >= popen_cnt);
+
+  coefficient_type h;
+  for (int i = 0; i < popen_cnt; i++)
+    {
+      h.almost_randomize(G);
+      combined_vals.add(vals[i], h);
+      combined_macs.add(h, macs[i]);
+    }
+
+  vals.erase(vals.begin(), vals.begin() + popen_cnt);
+  macs.erase(macs.begin(), macs.begin() + popen_cnt);
+  n_combined += popen_cnt;
+  popen_cnt = 0;
+}
+
+
+template<class U>
+void Tree_MAC_Check<U>::Combine(const Player& P)
+{
+  if (popen_cnt == 0)
+    return;
+
+  if (not chain_seeded)
+    {
+      this->timers[SEED].start();
+      Create_Random_Seed(chain, P, Hash::hash_length);
+      this->timers[SEED].stop();
+      chain_seeded = true;
+    }
+
+  // the coefficients depend on all values opened so far
+  chain_os.reset_write_head();
+  chain_os.append(chain, Hash::hash_length);
+  for (int i = 0; i < popen_cnt; i++)
+    vals[i].pack(chain_os);
+  Hash hash;
+  hash.update(chain_os);
+  hash.final(chain);
+
+  PRNG G;
+  G.SetSeed(chain);
+  AddToCombination(G);
+}
+
+
 template <class U>
 void Tree_MAC_Check<U>::AddToCheck(const U& share, const T& value, const Player& P)
 {
@@ -141,26 +198,60 @@ void Tree_MAC_Check<U>::AddToCheck(const U& share, const T& value, const Player&
 
 
 
+template<class U>
+void Tree_MAC_Check<U>::Check(const Player& P)
+{
+  if (WaitingForCheck() == 0)
+    return;
+
+  assert(int(macs.size()) <= popen_cnt);
+  assert(coordinator);
+
+  if (popen_cnt > 0)
+    {
+      // values not combined yet
+      octet seed[SEED_SIZE];
+      this->timers[SEED].start();
+      Create_Random_Seed(seed,P,SEED_SIZE);
+      this->timers[SEED].stop();
+      PRNG G;
+      G.SetSeed(seed);
+      AddToCombination(G);
+    }
+
+  typename U::mac_type a = combined_vals.get(), gami = combined_macs.get();
+  vector<typename U::mac_type> tau(P.num_players());
+  tau[P.my_num()] = gami - this->alphai * a;
+  n_combined = 0;
+  // limit the values any hash chain depends on to one check
+  chain_seeded = false;
+
+  this->timers[COMMIT].start();
+  Commit_And_Open(tau, P, *coordinator);
+  this->timers[COMMIT].stop();
+
+  typename U::mac_type t;
+  for (int i=0; i<P.num_players(); i++)
+    { t += tau[i]; }
+  if (t != 0)
+    throw mac_fail();
+}
+
 template<class U>
 void MAC_Check_<U>::Check(const Player& P)
 {
   assert(U::mac_type::invertible);
   check_field_size<typename U::mac_type>();
 
-  if (this->WaitingForCheck() == 0)
-    return;
-
-  //cerr << "In MAC Check : " << popen_cnt << endl;
-
   auto& vals = this->vals;
   auto& macs = this->macs;
   auto& popen_cnt = this->popen_cnt;
-  assert(int(macs.size()) <= popen_cnt);
-  assert(this->coordinator);
 
-  if (popen_cnt < 10)
+  if (popen_cnt > 0 and popen_cnt < 10 and this->n_combined == 0)
     {
       // no random combination with few values
+      assert(int(macs.size()) <= popen_cnt);
+      assert(this->coordinator);
       vector<typename U::mac_type> deltas;
       Bundle<octetStream> bundle(P);
       for (int i = 0; i < popen_cnt; i++)
@@ -168,6 +259,9 @@ void MAC_Check_<U>::Check(const Player& P)
           deltas.push_back(vals[i] * this->alphai - macs[i]);
           deltas.back().pack(bundle.mine);
         }
+      vals.erase(vals.begin(), vals.begin() + popen_cnt);
+      macs.erase(macs.begin(), macs.begin() + popen_cnt);
+      popen_cnt = 0;
       this->timers[COMMIT].start();
       Commit_And_Open_(bundle, P, *this->coordinator);
       this->timers[COMMIT].stop();
@@ -181,50 +275,7 @@ void MAC_Check_<U>::Check(const Player& P)
         }
     }
   else
-    {
-      // check random combination
-      octet seed[SEED_SIZE];
-      this->timers[SEED].start();
-      Create_Random_Seed(seed,P,SEED_SIZE);
-      this->timers[SEED].stop();
-      PRNG G;
-      G.SetSeed(seed);
-
-      U sj;
-      typename U::mac_type a,gami,temp;
-      typename U::mac_type::Scalar h;
-      vector<typename U::mac_type> tau(P.num_players());
-      for (int i=0; i<popen_cnt; i++)
-        {
-          h.almost_randomize(G);
-          temp = vals[i] * h;
-          a = (a + temp);
-
-          temp = h * macs[i];
-          gami = (gami + temp);
-        }
-
-      temp = this->alphai * a;
-      tau[P.my_num()] = (gami - temp);
-
-      //cerr << "\tCommit and Open" << endl;
-      this->timers[COMMIT].start();
-      Commit_And_Open(tau, P, *this->coordinator);
-      this->timers[COMMIT].stop();
-
-      //cerr << "\tFinal Check" << endl;
-
-      typename U::mac_type t;
-      for (int i=0; i<P.num_players(); i++)
-        { t += tau[i]; }
-      if (t != 0)
-        throw mac_fail();
-    }
-
-  vals.erase(vals.begin(), vals.begin() + popen_cnt);
-  macs.erase(macs.begin(), macs.begin() + popen_cnt);
-
-  popen_cnt=0;
+    Tree_MAC_Check<U>::Check(P);
 }
 
 template<class T, class U, class V, class W>
@@ -284,56 +335,6 @@ void MAC_Check_Z2k<T, U, V, W>::set_prep(Preprocessing<W>& prep)
   this->prep = &prep;
 }
 
-template<class T, class U, class V, class W>
-void MAC_Check_Z2k<T, U, V, W>::Check(const Player& P)
-{
-  if (this->WaitingForCheck() == 0)
-    return;
-
-#ifdef DEBUG_MAC
-  cout << "Checking " << shares[0] << " " << this->vals[0] << " " << this->macs[0] << endl;
-#endif
-
-  octet seed[SEED_SIZE];
-  Create_Random_Seed(seed,P,SEED_SIZE);
-  PRNG G;
-  G.SetSeed(seed);
-
-  T y, mj;
-  y.assign_zero();
-  mj.assign_zero();
-  vector<U> chi;
-  for (int i = 0; i < this->popen_cnt; ++i)
-  {
-    U temp_chi;
-    temp_chi.randomize(G);
-    T xi = this->vals[i];
-    y += xi * temp_chi;
-    T mji = this->macs[i];
-    mj += temp_chi * mji;
-    chi.push_back(temp_chi);
-  }
-
-  T zj = mj - this->alphai * y;
-  vector<T> zjs(P.num_players());
-  zjs[P.my_num()] = zj;
-
-  assert(this->coordinator);
-  Commit_And_Open(zjs, P, *this->coordinator);
-
-  T zj_sum;
-  zj_sum.assign_zero();
-  for (int i = 0; i < P.num_players(); ++i)
-    zj_sum += zjs[i];
-
-  this->vals.erase(this->vals.begin(), this->vals.begin() + this->popen_cnt);
-  this->macs.erase(this->macs.begin(), this->macs.begin() + this->popen_cnt);
-  this->popen_cnt=0;
-  if (!zj_sum.is_zero()) { throw mac_fail(); }
-}
-
-
-
 template<class T>
 Direct_MAC_Check<T>::Direct_MAC_Check(const typename T::mac_key_type::Scalar& ai,
     Names&, int) :
@@ -50,6 +50,8 @@ public:
 
     virtual void POpen_Begin(vector<typename T::open_type>& values,const vector<T>& S,const Player& P);
     virtual void POpen_End(vector<typename T::open_type>& values,const vector<T>& S,const Player& P);
+    /// Whether several openings can be begun before ending earlier ones
+    virtual bool pipelines_open() { return false; }
     /// Open values in ``S`` and store results in ``values``
     virtual void POpen(vector<typename T::open_type>& values,const vector<T>& S,const Player& P);
     typename T::open_type POpen(const T& secret, const Player& P);
@@ -33,7 +33,7 @@ void MaliciousDabitOnlyPrep<T>::buffer_dabits(ThreadQueues* queues, false_type,
     assert(this->proc != 0);
     vector<dabit<T>> check_dabits;
     this->buffer_dabits_without_check(check_dabits,
-            dabit_sacrifice.minimum_n_inputs(this->buffer_size), queues);
+            dabit_sacrifice.minimum_n_inputs(this->dabit_buffer_size()), queues);
     dabit_sacrifice.sacrifice_and_check_bits(this->dabits, check_dabits,
             *this->proc, queues);
 }
@@ -38,6 +38,8 @@ public:
     { (void)_; (void)__; (void)___; (void)____; }
 
     void init_open(const Player& P, int n = 0);
+    // checking needs all shares
+    void exchange(const Player& P) { this->direct_exchange(P); }
     typename T::open_type finalize_raw();
 
     typename T::open_type reconstruct(const vector<open_type>& shares);
@@ -74,6 +74,7 @@ public:
     static const int N_MACS = N;
 
     static const bool expensive = true;
+    static const bool background_prep = true;
 
     static string type_string()
     {
@@ -0,0 +1,82 @@
+/*
+ * PrepWorker.h
+ *
+ */
+
+#ifndef PROTOCOLS_PREPWORKER_H_
+#define PROTOCOLS_PREPWORKER_H_
+
+#include "Networking/Player.h"
+#include "Tools/time-func.h"
+
+#include <pthread.h>
+#include <deque>
+#include <array>
+using namespace std;
+
+/**
+ * Live preprocessing in a separate thread with a dedicated player
+ * instance, generating triples and bits ahead of the online phase.
+ * The queues are bounded in the sense that generation pauses once
+ * every party has enough of every type in use.
+ */
+template<class T>
+class PrepWorker
+{
+    enum Job
+    {
+        STOP = -2,
+        IDLE = -1,
+        TRIPLES,
+        BITS,
+        N_JOBS
+    };
+
+    // nanoseconds between agreement rounds without local demand
+    static const long MIN_IDLE_WAIT = 1000000;
+    static const long MAX_IDLE_WAIT = 1000000000;
+
+    pthread_t thread;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+
+    deque<vector<array<T, 3>>> triple_batches;
+    deque<vector<T>> bit_batches;
+    array<bool, N_JOBS> active;
+    size_t max_batches;
+    bool running, finished;
+    string error;
+
+    const Names& N;
+    int thread_num;
+    typename T::mac_key_type alphai;
+    bool encrypted;
+
+    static void* run_thread(void* worker);
+
+    // prevent copying
+    PrepWorker(const PrepWorker& other);
+
+    void run();
+    int proposal();
+    int agree(Player& P, int job);
+    template<class U>
+    void pop(deque<U>& queue, U& res, Job job);
+
+public:
+    NamedCommStats comm_stats;
+    Timer wait_timer;
+
+    PrepWorker(const Names& N, int thread_num,
+            typename T::mac_key_type alphai, bool encrypted,
+            size_t max_batches = 4);
+    ~PrepWorker();
+
+    /// Stop generation consistently among parties
+    void stop();
+
+    void pop(vector<array<T, 3>>& triples);
+    void pop(vector<T>& bits);
+};
+
+#endif /* PROTOCOLS_PREPWORKER_H_ */
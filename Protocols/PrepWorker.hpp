@@ -0,0 +1,242 @@
+/*
+ * PrepWorker.hpp
+ *
+ */
+
+#ifndef PROTOCOLS_PREPWORKER_HPP_
+#define PROTOCOLS_PREPWORKER_HPP_
+
+#include "PrepWorker.h"
+#include "Processor/BaseMachine.h"
+#include "Processor/Processor.h"
+#include "Networking/CryptoPlayer.h"
+#include "Tools/Bundle.h"
+
+#include <memory>
+
+template<class T>
+PrepWorker<T>::PrepWorker(const Names& N, int thread_num,
+        typename T::mac_key_type alphai, bool encrypted, size_t max_batches) :
+        max_batches(max_batches), running(true), finished(false), N(N),
+        thread_num(thread_num), alphai(alphai), encrypted(encrypted)
+{
+    active.fill(false);
+    pthread_mutex_init(&mutex, 0);
+    pthread_cond_init(&cond, 0);
+    pthread_create(&thread, 0, run_thread, this);
+}
+
+template<class T>
+PrepWorker<T>::~PrepWorker()
+{
+    stop();
+    pthread_mutex_destroy(&mutex);
+    pthread_cond_destroy(&cond);
+
+#ifdef VERBOSE
+    if (OnlineOptions::singleton.verbose)
+        cerr << "Waited " << wait_timer.elapsed()
+                << " seconds for background preprocessing of "
+                << T::type_string() << " in thread " << thread_num << endl;
+#endif
+}
+
+template<class T>
+void PrepWorker<T>::stop()
+{
+    pthread_mutex_lock(&mutex);
+    bool joinable = running;
+    running = false;
+    pthread_cond_broadcast(&cond);
+    pthread_mutex_unlock(&mutex);
+    if (joinable)
+        pthread_join(thread, 0);
+}
+
+template<class T>
+void* PrepWorker<T>::run_thread(void* worker)
+{
+    ((PrepWorker<T>*) worker)->run();
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L
+    OPENSSL_thread_stop();
+#endif
+    return 0;
+}
+
+template<class T>
+void PrepWorker<T>::run()
+{
+    bigint::init_thread();
+    BaseMachine::thread_num = thread_num;
+
+    try
+    {
+        string id = "prep" + to_string(thread_num);
+        unique_ptr<Player> P;
+        if (encrypted)
+            P.reset(new CryptoPlayer(N, id));
+        else
+            P.reset(new PlainPlayer(N, id));
+
+        {
+            typename T::MAC_Check MC(alphai);
+            DataPositions usage(P->num_players());
+            unique_ptr<Preprocessing<T>> prep(
+                    Preprocessing<T>::get_live_prep(0, usage));
+            SubProcessor<T> proc(MC, *prep, *P);
+
+            // back-off while idle, local demand wakes up immediately
+            long idle_wait = MIN_IDLE_WAIT;
+
+            while (true)
+            {
+                pthread_mutex_lock(&mutex);
+                int job = proposal();
+                pthread_mutex_unlock(&mutex);
+
+                job = agree(*P, job);
+                if (job == STOP)
+                    break;
+                if (job != IDLE)
+                    idle_wait = MIN_IDLE_WAIT;
+
+                switch (job)
+                {
+                case TRIPLES:
+                {
+                    vector<array<T, 3>> batch(
+                            BaseMachine::batch_size<T>(DATA_TRIPLE));
+                    for (auto& triple : batch)
+                        prep->get_three_no_count(DATA_TRIPLE, triple[0],
+                                triple[1], triple[2]);
+                    pthread_mutex_lock(&mutex);
+                    triple_batches.push_back(move(batch));
+                    break;
+                }
+                case BITS:
+                {
+                    vector<T> batch(BaseMachine::batch_size<T>(DATA_BIT));
+                    for (auto& bit : batch)
+                        prep->get_one_no_count(DATA_BIT, bit);
+                    pthread_mutex_lock(&mutex);
+                    bit_batches.push_back(move(batch));
+                    break;
+                }
+                default:
+                {
+                    // everyone has enough, wait for demand
+                    // (other parties' demand only shows in the next round)
+                    timespec deadline;
+                    clock_gettime(CLOCK_REALTIME, &deadline);
+                    deadline.tv_nsec += idle_wait;
+                    deadline.tv_sec += deadline.tv_nsec / 1000000000;
+                    deadline.tv_nsec %= 1000000000;
+                    idle_wait = min(2 * idle_wait, long(MAX_IDLE_WAIT));
+                    pthread_mutex_lock(&mutex);
+                    while (proposal() == IDLE)
+                        if (pthread_cond_timedwait(&cond, &mutex, &deadline)
+                                == ETIMEDOUT)
+                            break;
+                }
+                }
+
+                pthread_cond_broadcast(&cond);
+                pthread_mutex_unlock(&mutex);
+            }
+
+            MC.Check(*P);
+        }
+
+        comm_stats = P->total_comm();
+    }
+    catch (exception& e)
+    {
+        error = e.what();
+    }
+
+    pthread_mutex_lock(&mutex);
+    finished = true;
+    pthread_cond_broadcast(&cond);
+    pthread_mutex_unlock(&mutex);
+}
+
+template<class T>
+int PrepWorker<T>::proposal()
+{
+    // call with lock
+    if (not running)
+        return STOP;
+
+    size_t n_triples = active[TRIPLES] ? triple_batches.size() : max_batches;
+    size_t n_bits = active[BITS] ? bit_batches.size() : max_batches;
+    if (min(n_triples, n_bits) >= max_batches)
+        return IDLE;
+    else if (n_triples <= n_bits)
+        return TRIPLES;
+    else
+        return BITS;
+}
+
+template<class T>
+int PrepWorker<T>::agree(Player& P, int job)
+{
+    Bundle<octetStream> bundle(P);
+    bundle.mine.store(job);
+    P.unchecked_broadcast(bundle);
+
+    int res = IDLE;
+    for (auto& os : bundle)
+    {
+        int proposed;
+        os.get(proposed);
+        if (proposed == STOP)
+            return STOP;
+        if (res == IDLE)
+            res = proposed;
+    }
+    return res;
+}
+
+template<class T>
+template<class U>
+void PrepWorker<T>::pop(deque<U>& queue, U& res, Job job)
+{
+    pthread_mutex_lock(&mutex);
+    if (not active[job])
+    {
+        active[job] = true;
+        pthread_cond_broadcast(&cond);
+    }
+
+    if (queue.empty())
+    {
+        TimeScope _(wait_timer);
+        while (queue.empty() and not finished)
+            pthread_cond_wait(&cond, &mutex);
+    }
+
+    if (queue.empty())
+    {
+        pthread_mutex_unlock(&mutex);
+        throw runtime_error("background preprocessing stopped: " + error);
+    }
+
+    res = move(queue.front());
+    queue.pop_front();
+    pthread_cond_broadcast(&cond);
+    pthread_mutex_unlock(&mutex);
+}
+
+template<class T>
+void PrepWorker<T>::pop(vector<array<T, 3>>& triples)
+{
+    pop(triple_batches, triples, TRIPLES);
+}
+
+template<class T>
+void PrepWorker<T>::pop(vector<T>& bits)
+{
+    pop(bit_batches, bits, BITS);
+}
+
+#endif /* PROTOCOLS_PREPWORKER_HPP_ */
@@ -8,6 +8,31 @@
 
 #include "SecureShuffle.h"
 
+class ThreadJob;
+
+/**
+ * Values input by two of three parties and summed by everyone,
+ * which allows splitting the resharing among threads by range
+ */
+template<class T>
+class Rep3Resharing
+{
+public:
+    vector<typename T::open_type> to_share;
+    // end of range and first of the two consecutive inputting parties
+    vector<pair<size_t, int>> dealers;
+    vector<T> results;
+
+    void run(SubProcessor<T>& proc, size_t begin, size_t end);
+
+    static void run_job(const ThreadJob& job, SubProcessor<T>& proc,
+            true_type);
+    static void run_job(const ThreadJob&, SubProcessor<T>&, false_type)
+    {
+        throw runtime_error("resharing only with replicated shuffling");
+    }
+};
+
 template<class T>
 class Rep3Shuffler
 {
@@ -18,6 +43,11 @@ public:
 private:
     SubProcessor<T>& proc;
 
+    static void permute(typename T::open_type* dest, const T* source,
+            const vector<int>& perm, int unit_size, bool reverse, bool sum);
+
+    void reshare(Rep3Resharing<T>& resharing);
+
 public:
     Rep3Shuffler(vector<T>& a, size_t n, int unit_size, size_t output_base,
             size_t input_base, SubProcessor<T>& proc);
@@ -29,6 +59,14 @@ public:
     void apply(vector<T>& a, size_t n, int unit_size, size_t output_base,
             size_t input_base, shuffle_type& shuffle, bool reverse);
 
+    /**
+     * Apply several shuffles with one resharing round per party pair
+     * for all of them. Several columns can be permuted the same way
+     * by repeating the shuffle or by a larger unit size.
+     */
+    void apply_multiple(vector<T>& a, const vector<int>& args,
+            vector<shuffle_type*>& shuffles);
+
     void inverse_permutation(vector<T>& stack, size_t n, size_t output_base,
             size_t input_base);
 };
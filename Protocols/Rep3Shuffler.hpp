@@ -7,6 +7,8 @@
 #define PROTOCOLS_REP3SHUFFLER_HPP_
 
 #include "Rep3Shuffler.h"
+#include "Processor/BaseMachine.h"
+#include "Processor/ThreadJob.h"
 
 template<class T>
 Rep3Shuffler<T>::Rep3Shuffler(vector<T>& a, size_t n, int unit_size,
@@ -48,75 +50,161 @@ template<class T>
 void Rep3Shuffler<T>::apply(vector<T>& a, size_t n, int unit_size,
         size_t output_base, size_t input_base, shuffle_type& shuffle,
         bool reverse)
+{
+    vector<int> args = {int(n), int(output_base), int(input_base), unit_size,
+            -1, reverse};
+    vector<shuffle_type*> shuffles = {&shuffle};
+    apply_multiple(a, args, shuffles);
+}
+
+template<class T>
+void Rep3Shuffler<T>::apply_multiple(vector<T>& a, const vector<int>& args,
+        vector<shuffle_type*>& shuffles)
 {
     assert(proc.P.num_players() == 3);
     assert(not T::malicious);
     assert(not T::dishonest_majority);
-    assert(n % unit_size == 0);
-
-    if (shuffle.empty())
-        throw runtime_error("shuffle has been deleted");
+    assert(args.size() == 6 * shuffles.size());
 
-    vector<T> to_shuffle;
-    for (size_t i = 0; i < n; i++)
-        to_shuffle.push_back(a[input_base + i]);
+    size_t n_shuffles = shuffles.size();
+    vector<size_t> offsets(n_shuffles + 1);
+    for (size_t s = 0; s < n_shuffles; s++)
+    {
+        auto it = args.begin() + 6 * s;
+        assert(it[0] % it[3] == 0);
+        if (shuffles[s]->at(0).empty())
+            throw runtime_error("shuffle has been deleted");
+        assert(shuffles[s]->at(0).size() * it[3] == size_t(it[0]));
+        offsets[s + 1] = offsets[s] + it[0];
+    }
 
-    typename T::Input input(proc);
+    vector<T> to_shuffle(offsets.back());
+    for (size_t s = 0; s < n_shuffles; s++)
+    {
+        auto it = args.begin() + 6 * s;
+        copy(a.begin() + it[2], a.begin() + it[2] + it[0],
+                to_shuffle.begin() + offsets[s]);
+    }
 
-    vector<typename T::clear> to_share(n);
+    Rep3Resharing<T> resharing;
+    resharing.to_share.resize(offsets.back());
 
     for (int ii = 0; ii < 3; ii++)
     {
-        int i;
-        if (reverse)
-            i = 2 - ii;
-        else
-            i = ii;
-
-        if (proc.P.get_player(i) == 0)
+        resharing.dealers.clear();
+        for (size_t s = 0; s < n_shuffles; s++)
         {
-            for (size_t j = 0; j < n / unit_size; j++)
-                for (int k = 0; k < unit_size; k++)
-                    if (reverse)
-                        to_share.at(j * unit_size + k) = to_shuffle.at(
-                                shuffle[0].at(j) * unit_size + k).sum();
-                    else
-                        to_share.at(shuffle[0].at(j) * unit_size + k) =
-                                to_shuffle.at(j * unit_size + k).sum();
-        }
-        else if (proc.P.get_player(i) == 1)
-        {
-            for (size_t j = 0; j < n / unit_size; j++)
-                for (int k = 0; k < unit_size; k++)
-                    if (reverse)
-                        to_share[j * unit_size + k] = to_shuffle[shuffle[1][j]
-                                * unit_size + k][0];
-                    else
-                        to_share[shuffle[1][j] * unit_size + k] = to_shuffle[j
-                                * unit_size + k][0];
+            auto it = args.begin() + 6 * s;
+            int unit_size = it[3];
+            bool reverse = it[5];
+            int i = reverse ? 2 - ii : ii;
+
+            // the first two players relative to the offset
+            // permute their sum respectively their first component
+            int dealer = (3 - i) % 3;
+            int role = (proc.P.my_num() - dealer + 3) % 3;
+            if (role < 2)
+                permute(&resharing.to_share[offsets[s]],
+                        &to_shuffle[offsets[s]], shuffles[s]->at(role),
+                        unit_size, reverse, role == 0);
+            resharing.dealers.push_back({offsets[s + 1], dealer});
         }
 
-        input.reset_all(proc.P);
+        reshare(resharing);
+        swap(to_shuffle, resharing.results);
+    }
+
+    for (size_t s = 0; s < n_shuffles; s++)
+    {
+        auto it = args.begin() + 6 * s;
+        copy(to_shuffle.begin() + offsets[s],
+                to_shuffle.begin() + offsets[s + 1], a.begin() + it[1]);
+    }
+}
+
+template<class T>
+void Rep3Shuffler<T>::permute(typename T::open_type* dest, const T* source,
+        const vector<int>& perm, int unit_size, bool reverse, bool sum)
+{
+    // branch-free inner loops over contiguous units
+    size_t n_blocks = perm.size();
+    for (size_t j = 0; j < n_blocks; j++)
+    {
+        size_t from = (reverse ? perm[j] : j) * unit_size;
+        size_t to = (reverse ? j : perm[j]) * unit_size;
+        auto x = source + from;
+        auto y = dest + to;
+        if (sum)
+            for (int k = 0; k < unit_size; k++)
+                y[k] = x[k].sum();
+        else
+            for (int k = 0; k < unit_size; k++)
+                y[k] = x[k][0];
+    }
+}
+
+template<class T>
+void Rep3Shuffler<T>::reshare(Rep3Resharing<T>& resharing)
+{
+    size_t n = resharing.to_share.size();
+    resharing.results.resize(n);
 
-        if (proc.P.get_player(i) < 2)
-            for (auto& x : to_share)
-                input.add_mine(x);
+    // idle threads take ranges with their own connections
+    if (BaseMachine::thread_num == 0 and BaseMachine::has_singleton()
+            and not T::clear::characteristic_two)
+    {
+        auto& queues = BaseMachine::s().queues;
+        ReshareJob job(&resharing);
+        int start = queues.distribute(job, n);
+        resharing.run(proc, start, n);
+        if (start)
+            queues.wrap_up(job);
+    }
+    else
+        resharing.run(proc, 0, n);
+}
 
-        for (int k = 0; k < 2; k++)
-            input.add_other((-i + 3 + k) % 3);
+template<class T>
+void Rep3Resharing<T>::run_job(const ThreadJob& job, SubProcessor<T>& proc,
+        true_type)
+{
+    ((Rep3Resharing<T>*) job.output)->run(proc, job.begin, job.end);
+}
 
-        input.exchange();
-        to_shuffle.clear();
+template<class T>
+void Rep3Resharing<T>::run(SubProcessor<T>& proc, size_t begin, size_t end)
+{
+    auto& P = proc.P;
+    auto& input = proc.input;
+    input.reset_all(P);
 
-        for (size_t j = 0; j < n; j++)
-        {
-            T x = input.finalize((-i + 3) % 3) + input.finalize((-i + 4) % 3);
-            to_shuffle.push_back(x);
-        }
+    size_t range_begin = 0;
+    for (auto& x : dealers)
+    {
+        size_t b = max(begin, range_begin), e = min(end, x.first);
+        if (b < e)
+            for (int k = 0; k < 2; k++)
+            {
+                int player = (x.second + k) % 3;
+                if (player == P.my_num())
+                    for (size_t j = b; j < e; j++)
+                        input.add_mine(to_share[j]);
+                else
+                    input.add_other(player);
+            }
+        range_begin = x.first;
     }
 
-    for (size_t i = 0; i < n; i++)
-        a[output_base + i] = to_shuffle[i];
+    input.exchange();
+
+    range_begin = 0;
+    for (auto& x : dealers)
+    {
+        int first = x.second, second = (x.second + 1) % 3;
+        for (size_t j = max(begin, range_begin); j < min(end, x.first); j++)
+            results[j] = input.finalize(first) + input.finalize(second);
+        range_begin = x.first;
+    }
 }
 
 template<class T>
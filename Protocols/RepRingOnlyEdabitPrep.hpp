@@ -12,7 +12,7 @@ void RepRingOnlyEdabitPrep<T>::buffer_edabits(int n_bits, ThreadQueues*)
 {
     assert(this->proc);
     int dl = T::bit_type::default_length;
-    int buffer_size = DIV_CEIL(BaseMachine::edabit_batch_size<T>(n_bits, this->buffer_size), dl) * dl;
+    int buffer_size = DIV_CEIL(BaseMachine::edabit_batch_size<T>(n_bits, this->edabit_buffer_size()), dl) * dl;
     vector<T> wholes;
     wholes.resize(buffer_size);
     Instruction inst;
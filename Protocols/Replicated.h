@@ -9,6 +9,7 @@
 #include <assert.h>
 #include <vector>
 #include <array>
+#include <deque>
 using namespace std;
 
 #include "Tools/octetStream.h"
@@ -16,6 +17,7 @@ using namespace std;
 #include "Tools/PointerVector.h"
 #include "Networking/Player.h"
 #include "Processor/Memory.h"
+#include "Math/DotProduct.h"
 
 template<class T> class SubProcessor;
 template<class T> class ReplicatedMC;
@@ -49,6 +51,12 @@ public:
 template <class T>
 class ProtocolBase
 {
+    // Two batches in flight have to fit the socket buffers because
+    // sending blocks otherwise, and all parties sending at the same
+    // time would then deadlock. Receiving in a separate thread would
+    // avoid this, which is why --pipeline is not the default.
+    static const size_t PIPELINE_BYTES = 1 << 15;
+
     virtual void buffer_random() { throw not_implemented(); }
 
 protected:
@@ -118,9 +126,20 @@ public:
     void conv2ds(SubProcessor<T>& proc, const Instruction& instruction)
     { proc.conv2ds(instruction); }
 
+    /// Start multiplication protocol without waiting for the result
     virtual void start_exchange() { exchange(); }
+    /// Finish oldest multiplication round started
     virtual void stop_exchange() {}
 
+    /// Whether further rounds can be started before stopping earlier ones
+    virtual bool pipelines_exchange() { return false; }
+    /// Get what all rounds of a pipeline need before starting the first
+    virtual void start_pipeline(size_t) {}
+
+    bool pipelines(size_t n_mults);
+    template<class U, class V>
+    void pipeline(size_t n_mults, const U& prepare, const V& finalize);
+
     virtual void check() {}
 
     virtual void cisc(SubProcessor<T>&, const Instruction&)
@@ -139,7 +158,9 @@ class Replicated : public ReplicatedBase, public ProtocolBase<T>
 {
     array<octetStream, 2> os;
     PointerVector<typename T::clear> add_shares;
+    deque<PointerVector<typename T::clear>> pending_shares;
     typename T::clear dotprod_share;
+    DotProduct<typename T::clear> dotprod;
 
     template<class U>
     void trunc_pr(const vector<int>& regs, int size, U& proc, true_type);
@@ -182,6 +203,7 @@ public:
 
     void start_exchange();
     void stop_exchange();
+    bool pipelines_exchange() { return true; }
 };
 
 #endif /* PROTOCOLS_REPLICATED_H_ */
@@ -96,6 +96,19 @@ void ProtocolBase<T>::multiply(vector<T>& products,
 #endif
 
     init(proc.DataF, proc.MC);
+    if (pipelines(end - begin))
+    {
+        pipeline(end - begin, [&](size_t i)
+        {
+            prepare_mul(multiplicands[begin + i].first,
+                    multiplicands[begin + i].second);
+        }, [&](size_t i)
+        {
+            products[begin + i] = finalize_mul();
+        });
+        return;
+    }
+
     init_mul();
     for (int i = begin; i < end; i++)
         prepare_mul(multiplicands[i].first, multiplicands[i].second);
@@ -126,6 +139,43 @@ void ProtocolBase<T>::finalize_mult(T& res, int n)
     res = finalize_mul(n);
 }
 
+template<class T>
+bool ProtocolBase<T>::pipelines(size_t n_mults)
+{
+    size_t batch_size = max(size_t(1), PIPELINE_BYTES / T::clear::size());
+    return OnlineOptions::singleton.pipeline and n_mults >= 2 * batch_size
+            and pipelines_exchange();
+}
+
+template<class T>
+template<class U, class V>
+void ProtocolBase<T>::pipeline(size_t n_mults, const U& prepare,
+        const V& finalize)
+{
+    // prepare and send the next batch while the previous one is in flight
+    size_t batch_size = max(size_t(1), PIPELINE_BYTES / T::clear::size());
+    size_t n_batches = DIV_CEIL(n_mults, batch_size);
+    start_pipeline(n_mults);
+    for (size_t i = 0; i <= n_batches; i++)
+    {
+        if (i < n_batches)
+        {
+            init_mul();
+            for (size_t j = i * batch_size;
+                    j < min(n_mults, (i + 1) * batch_size); j++)
+                prepare(j);
+            start_exchange();
+        }
+        if (i > 0)
+        {
+            stop_exchange();
+            for (size_t j = (i - 1) * batch_size;
+                    j < min(n_mults, i * batch_size); j++)
+                finalize(j);
+        }
+    }
+}
+
 template<class T>
 T ProtocolBase<T>::finalize_dotprod(int length)
 {
@@ -203,13 +253,19 @@ void Replicated<T>::start_exchange()
 {
     os[0].append(0);
     P.send_relative(1, os[0]);
-    this->rounds++;
+    // overlapping rounds only cost one
+    if (pending_shares.empty())
+        this->rounds++;
+    pending_shares.push_back(move(add_shares));
 }
 
 template<class T>
 void Replicated<T>::stop_exchange()
 {
+    assert(not pending_shares.empty());
     P.receive_relative(-1, os[1]);
+    add_shares = move(pending_shares.front());
+    pending_shares.pop_front();
 }
 
 template<class T>
@@ -233,12 +289,21 @@ inline void Replicated<T>::init_dotprod()
 template<class T>
 inline void Replicated<T>::prepare_dotprod(const T& x, const T& y)
 {
-    dotprod_share = dotprod_share.lazy_add(x.local_mul(y));
+    if (DotProduct<typename T::clear>::LAZY)
+    {
+        // same as local_mul() but with a single reduction per dot product
+        dotprod.add(x[0], y.lazy_sum());
+        dotprod.add(x[1], y[0]);
+    }
+    else
+        dotprod_share = dotprod_share.lazy_add(x.local_mul(y));
 }
 
 template<class T>
 inline void Replicated<T>::next_dotprod()
 {
+    if (DotProduct<typename T::clear>::LAZY)
+        dotprod_share = dotprod.get();
     dotprod_share.normalize();
     prepare_reshare(dotprod_share);
     dotprod_share.assign_zero();
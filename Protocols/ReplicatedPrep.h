@@ -27,6 +27,8 @@ namespace GC
 template<class T> class ShareThread;
 }
 
+template<class T> class PrepWorker;
+
 /**
  * Abstract base class for live preprocessing
  */
@@ -61,6 +63,8 @@ protected:
     SubProcessor<T>* proc;
     Player* P;
 
+    PrepWorker<T>* worker;
+
     virtual void buffer_triples() { throw runtime_error("no triples"); }
     virtual void buffer_squares() { throw runtime_error("no squares"); }
     virtual void buffer_inverses();
@@ -91,6 +95,8 @@ public:
     typedef T share_type;
 
     int buffer_size;
+    // only for large requests of daBits or edaBits, see bulk_scope()
+    int dabit_bulk_size, edabit_bulk_size;
 
     /// Key-independent setup if necessary (cryptosystem parameters)
     static void basic_setup(Player& P) { (void) P; }
@@ -112,6 +118,11 @@ public:
     BufferPrep(DataPositions& usage);
     virtual ~BufferPrep();
 
+    int dabit_buffer_size()
+    { return dabit_bulk_size ? dabit_bulk_size : buffer_size; }
+    int edabit_buffer_size()
+    { return edabit_bulk_size ? edabit_bulk_size : buffer_size; }
+
     void clear();
 
     void get_three_no_count(Dtype dtype, T& a, T& b, T& c);
@@ -142,6 +153,9 @@ public:
     SubProcessor<T>* get_proc() { return proc; }
     void set_proc(SubProcessor<T>* proc) { this->proc = proc; }
 
+    /// Use triples and bits from background generation
+    void set_worker(PrepWorker<T>* worker) { this->worker = worker; }
+
     void buffer_extra(Dtype type, int n_items);
 };
 
@@ -273,14 +287,14 @@ public:
     { this->buffer_inputs_as_usual(player, this->proc); }
 
     virtual void buffer_dabits(ThreadQueues*)
-    { this->buffer_dabits_without_check(this->dabits); }
+    { this->buffer_dabits_without_check(this->dabits, this->dabit_buffer_size()); }
     virtual void buffer_edabits(int n_bits, ThreadQueues*)
     { buffer_edabits<0>(n_bits, T::clear::characteristic_two); }
     template<int>
     void buffer_edabits(int n_bits, false_type)
     { this->template buffer_edabits_without_check<0>(n_bits,
             this->edabits[{false, n_bits}],
-            BaseMachine::edabit_batch_size<T>(n_bits, this->buffer_size)); }
+            BaseMachine::edabit_batch_size<T>(n_bits, this->edabit_buffer_size())); }
     template<int>
     void buffer_edabits(int, true_type)
     { throw not_implemented(); }
@@ -17,6 +17,7 @@
 #include "Protocols/Rep3Share.h"
 
 #include "MaliciousRingPrep.hpp"
+#include "PrepWorker.hpp"
 #include "ShuffleSacrifice.hpp"
 #include "GC/ShareThread.hpp"
 #include "GC/BitAdder.hpp"
@@ -62,8 +63,8 @@ public:
 template<class T>
 BufferPrep<T>::BufferPrep(DataPositions& usage) :
         Preprocessing<T>(usage), n_bit_rounds(0),
-		proc(0), P(0),
-        buffer_size(0)
+		proc(0), P(0), worker(0),
+        buffer_size(0), dabit_bulk_size(0), edabit_bulk_size(0)
 {
 }
 
@@ -107,6 +108,12 @@ BufferPrep<T>::~BufferPrep()
     X(inverses, DATA_INVERSE)
 #undef X
 
+    BaseMachine::print_refills(type_string, DATA_TRIPLE, triples.size());
+    BaseMachine::print_refills(type_string, DATA_SQUARE, squares.size());
+    BaseMachine::print_refills(type_string, DATA_INVERSE, inverses.size());
+    BaseMachine::print_refills(type_string, DATA_BIT, bits.size());
+    BaseMachine::print_refills(type_string, DATA_DABIT, dabits.size());
+
     for (auto& x : this->edabits)
     {
         this->print_left_edabits(x.second.size(), x.second[0].size(),
@@ -221,8 +228,13 @@ void BufferPrep<T>::get_three_no_count(Dtype dtype, T& a, T& b, T& c)
     if (triples.empty())
     {
         InScope in_scope(this->do_count, false, *this);
-        buffer_triples();
+        if (worker)
+            worker->pop(triples);
+        else
+            buffer_triples();
         assert(not triples.empty());
+        BaseMachine::count_refill(T::type_string(), DATA_TRIPLE,
+                triples.size());
     }
 
     a = triples.back()[0];
@@ -322,6 +334,8 @@ void BufferPrep<T>::get_two_no_count(Dtype dtype, T& a, T& b)
         {
             InScope in_scope(this->do_count, false, *this);
             buffer_squares();
+            BaseMachine::count_refill(T::type_string(), DATA_SQUARE,
+                    squares.size());
         }
 
         a = squares.back()[0];
@@ -335,6 +349,8 @@ void BufferPrep<T>::get_two_no_count(Dtype dtype, T& a, T& b)
         {
             InScope in_scope(this->do_count, false, *this);
             buffer_inverses();
+            BaseMachine::count_refill(T::type_string(), DATA_INVERSE,
+                    inverses.size());
         }
 
         a = inverses.back()[0];
@@ -723,7 +739,7 @@ void SemiRep3Prep<T>::buffer_dabits(ThreadQueues*)
 
     typedef typename T::bit_type BT;
     int n_blocks = DIV_CEIL(
-            BaseMachine::batch_size<T>(DATA_DABIT, this->buffer_size),
+            BaseMachine::batch_size<T>(DATA_DABIT, this->dabit_buffer_size()),
             BT::default_length);
     int n_bits = n_blocks * BT::default_length;
 
@@ -951,7 +967,8 @@ template<int>
 void RingPrep<T>::buffer_sedabits_from_edabits(int n_bits, false_type)
 {
     assert(this->proc != 0);
-    size_t buffer_size = DIV_CEIL(BaseMachine::edabit_batch_size<T>(n_bits),
+    size_t buffer_size = DIV_CEIL(
+            BaseMachine::edabit_batch_size<T>(n_bits, this->edabit_buffer_size()),
             edabitvec<T>::MAX_SIZE);
 #ifdef VERBOSE_EDA
     fprintf(stderr, "sedabit buffer size %zu\n", buffer_size);
@@ -1145,8 +1162,12 @@ void BufferPrep<T>::get_one_no_count(Dtype dtype, T& a)
     while (bits.empty())
     {
         InScope in_scope(this->do_count, false, *this);
-        buffer_bits();
+        if (worker)
+            worker->pop(bits);
+        else
+            buffer_bits();
         n_bit_rounds++;
+        BaseMachine::count_refill(T::type_string(), DATA_BIT, bits.size());
     }
 
     a = bits.back();
@@ -1178,6 +1199,8 @@ void BufferPrep<T>::get_dabit_no_count(T& a, typename T::bit_type& b)
         ThreadQueues* queues = 0;
         buffer_dabits(queues);
         assert(not dabits.empty());
+        BaseMachine::count_refill(T::type_string(), DATA_DABIT,
+                dabits.size());
     }
     a = dabits.back().first;
     b = dabits.back().second;
@@ -1205,6 +1228,43 @@ void Preprocessing<T>::get_dabit(T& a, typename T::bit_type& b)
     this->count(DATA_DABIT);
 }
 
+template<class T>
+void Preprocessing<T>::get_dabits(size_t size, T* a,
+        vector<typename T::bit_type>& Sb, int reg)
+{
+    typedef typename T::bit_type BT;
+    size_t unit = BT::default_length;
+    auto scope = bulk_scope(size, false);
+    BT b;
+    for (size_t k = 0; k < size_t(DIV_CEIL(size, unit)); k++)
+    {
+        BT bits;
+        for (size_t i = k * unit; i < min(size, (k + 1) * unit); i++)
+        {
+            get_dabit(a[i], b);
+            bits ^= b << (i % unit);
+        }
+        Sb[reg + k] = bits;
+    }
+}
+
+/**
+ * Generate daBits or edaBits for a large request in one batch, which
+ * spreads the work across the thread queues where available
+ */
+template<class T>
+unique_ptr<BulkScope> Preprocessing<T>::bulk_scope(size_t size, bool edabits)
+{
+    unique_ptr<BulkScope> res;
+    auto prep = dynamic_cast<BufferPrep<T>*>(this);
+    if (prep and size > size_t(OnlineOptions::singleton.batch_size))
+        res.reset(
+                new BulkScope(
+                        edabits ? prep->edabit_bulk_size : prep->dabit_bulk_size,
+                        BaseMachine::bulk_batch_size<T>(size)));
+    return res;
+}
+
 template<class T>
 edabitvec<T> BufferPrep<T>::get_edabitvec(bool strict, int n_bits)
 {
@@ -1261,6 +1321,7 @@ void Preprocessing<T>::get_edabits(bool strict, size_t size, T* a,
     int n_bits = regs.size();
     edabit<T> eb;
     size_t unit = T::bit_type::default_length;
+    auto scope = bulk_scope(size, true);
     for (int k = 0; k < DIV_CEIL(size, unit); k++)
     {
 
@@ -1378,21 +1439,32 @@ template<class T>
 void BufferPrep<T>::buffer_extra(Dtype type, int n_items)
 {
     BufferScope<T> scope(*this, n_items);
+    size_t before, after;
 
     switch (type)
     {
     case DATA_TRIPLE:
+        before = triples.size();
         buffer_triples();
+        after = triples.size();
         break;
     case DATA_SQUARE:
+        before = squares.size();
         buffer_squares();
+        after = squares.size();
         break;
     case DATA_BIT:
+        before = bits.size();
         buffer_bits();
+        after = bits.size();
         break;
     default:
         throw not_implemented();
     }
+
+    // some generators replace the buffer instead of appending
+    BaseMachine::count_refill(T::type_string(), type,
+            after >= before ? after - before : after);
 }
 
 #endif
@@ -10,6 +10,10 @@
 using namespace std;
 
 #include "Tools/Lock.h"
+#include "Tools/PointerVector.h"
+
+#include <math.h>
+#include <algorithm>
 
 template<class T> class SubProcessor;
 
@@ -31,6 +35,44 @@ public:
     void del(int handle);
 };
 
+/**
+ * One application of a shuffle: the arguments as given in
+ * ``applyshuffle`` and the elements on their way through the network
+ */
+template<class T>
+class ShuffleTuple
+{
+public:
+    size_t n, output_base, input_base;
+    int unit_size;
+    bool reverse;
+
+    vector<T> to_shuffle;
+    const vector<vector<T>>* config;
+    int shuffle_unit_size;
+    size_t n_shuffle;
+    bool exact;
+
+    ShuffleTuple(size_t n, int unit_size, size_t output_base,
+            size_t input_base, bool reverse = false) :
+            n(n), output_base(output_base), input_base(input_base),
+            unit_size(unit_size), reverse(reverse), config(0),
+            shuffle_unit_size(unit_size), n_shuffle(0), exact(false)
+    {
+    }
+
+    int n_elements() const
+    {
+        return to_shuffle.size() / shuffle_unit_size;
+    }
+
+    /// Number of layers of the Waksman network
+    int n_layers() const
+    {
+        return max(0, 2 * int(log2(n_elements())) - 1);
+    }
+};
+
 template<class T>
 class SecureShuffle
 {
@@ -40,13 +82,7 @@ public:
 
 private:
     SubProcessor<T>& proc;
-    vector<T> to_shuffle;
     vector<vector<T>> config;
-    vector<T> tmp;
-    int unit_size;
-
-    size_t n_shuffle;
-    bool exact;
 
     /**
      * Generates and returns a newly generated random permutation. This permutation is generated locally.
@@ -69,16 +105,18 @@ private:
      * @param n_shuffle The size of the permutation to generate.
      */
     void configure(int config_player, vector<int>* perm, int n);
-    void player_round(int config_player);
+    void player_round(vector<ShuffleTuple<T>>& tuples, int config_player);
 
     void waksman(vector<T>& a, int depth, int start);
     void cond_swap(T& x, T& y, const T& b);
 
-    void iter_waksman(bool reverse = false);
-    void waksman_round(int size, bool inwards, bool reverse);
+    void iter_waksman(vector<ShuffleTuple<T>>& tuples);
+    void waksman_round(vector<ShuffleTuple<T>>& tuples, int layer);
+    void multiply(PointerVector<T>& products,
+            vector<pair<T, T>>& multiplicands);
 
-    void pre(vector<T>& a, size_t n, size_t input_base);
-    void post(vector<T>& a, size_t n, size_t input_base);
+    void pre(ShuffleTuple<T>& tuple, vector<T>& a);
+    void post(vector<ShuffleTuple<T>>& tuples, vector<T>& a);
 
 public:
     SecureShuffle(vector<T>& a, size_t n, int unit_size,
@@ -104,6 +142,19 @@ public:
     void apply(vector<T>& a, size_t n, int unit_size, size_t output_base,
             size_t input_base, shuffle_type& shuffle, bool reverse);
 
+    /**
+     * Apply several shuffles concurrently. The Waksman networks of all
+     * shuffles are traversed in lock-step, so every layer takes only
+     * one round of communication for all shuffles together.
+     *
+     * @param a The vector of registers
+     * @param args Groups of six as in ``applyshuffle``: size, output base,
+     *             input base, unit size, (unused) handle, reverse
+     * @param shuffles The shuffle for every group of arguments
+     */
+    void apply_multiple(vector<T>& a, const vector<int>& args,
+            vector<shuffle_type*>& shuffles);
+
     /**
      * Calculate the secret inverse permutation of stack given secret permutation.
      *
@@ -8,6 +8,8 @@
 
 #include "SecureShuffle.h"
 #include "Tools/Waksman.h"
+#include "Processor/BaseMachine.h"
+#include "Processor/OnlineOptions.h"
 
 #include <math.h>
 #include <algorithm>
@@ -53,47 +55,67 @@ void ShuffleStore<T>::del(int handle)
 
 template<class T>
 SecureShuffle<T>::SecureShuffle(SubProcessor<T>& proc) :
-        proc(proc), unit_size(0), n_shuffle(0), exact(false)
+        proc(proc)
 {
 }
 
 template<class T>
 SecureShuffle<T>::SecureShuffle(vector<T>& a, size_t n, int unit_size,
         size_t output_base, size_t input_base, SubProcessor<T>& proc) :
-        proc(proc), unit_size(unit_size), n_shuffle(0), exact(false)
+        proc(proc)
 {
-    pre(a, n, input_base);
+    vector<ShuffleTuple<T>> tuples;
+    tuples.push_back({n, unit_size, output_base, input_base});
+    pre(tuples[0], a);
 
     for (auto i : proc.protocol.get_relevant_players())
-        player_round(i);
+        player_round(tuples, i);
 
-    post(a, n, output_base);
+    post(tuples, a);
 }
 
 template<class T>
 void SecureShuffle<T>::apply(vector<T>& a, size_t n, int unit_size, size_t output_base,
         size_t input_base, shuffle_type& shuffle, bool reverse)
 {
-    this->unit_size = unit_size;
+    vector<int> args = {int(n), int(output_base), int(input_base), unit_size,
+            -1, reverse};
+    vector<shuffle_type*> shuffles = {&shuffle};
+    apply_multiple(a, args, shuffles);
+}
 
-    pre(a, n, input_base);
+template<class T>
+void SecureShuffle<T>::apply_multiple(vector<T>& a, const vector<int>& args,
+        vector<shuffle_type*>& shuffles)
+{
+    assert(args.size() == 6 * shuffles.size());
+    size_t n_networks = proc.protocol.get_relevant_players().size();
 
-    assert(shuffle.size() == proc.protocol.get_relevant_players().size());
+    vector<ShuffleTuple<T>> tuples;
+    tuples.reserve(shuffles.size());
+    for (size_t i = 0; i < shuffles.size(); i++)
+    {
+        if (shuffles[i]->empty())
+            throw runtime_error("shuffle has been deleted");
+        assert(shuffles[i]->size() == n_networks);
+        auto it = args.begin() + 6 * i;
+        tuples.push_back({size_t(it[0]), it[3], size_t(it[1]), size_t(it[2]),
+            bool(it[5])});
+        pre(tuples.back(), a);
+    }
 
-    if (reverse)
-        for (auto it = shuffle.end(); it > shuffle.begin(); it--)
-        {
-            this->config = *(it - 1);
-            iter_waksman(reverse);
-        }
-    else
-        for (auto& config : shuffle)
+    for (size_t k = 0; k < n_networks; k++)
+    {
+        for (size_t i = 0; i < tuples.size(); i++)
         {
-            this->config = config;
-            iter_waksman(reverse);
+            auto& tuple = tuples[i];
+            tuple.config = &shuffles[i]->at(
+                    tuple.reverse ? n_networks - 1 - k : k);
         }
+        iter_waksman(tuples);
+    }
 
-    post(a, n, output_base);
+    post(tuples, a);
 }
 
 
@@ -111,13 +133,14 @@ void SecureShuffle<T>::inverse_permutation(vector<T> &stack, size_t n, size_t ou
     // The current implementation assumes a semi-honest environment
     assert(!T::malicious);
 
-    // We are dealing directly with permutations, so the unit_size will always be 1.
-    this->unit_size = 1;
     // We need to account for sizes which are not a power of 2
     size_t n_pow2 = (1u << int(ceil(log2(n))));
 
     // Copy over the input registers
-    pre(stack, n, input_base);
+    // We are dealing directly with permutations, so the unit_size will always be 1.
+    vector<ShuffleTuple<T>> tuples;
+    tuples.push_back({n, 1, output_base, input_base, true});
+    pre(tuples[0], stack);
     // Alice generates stack local permutation and shares the waksman configuration bits secretly to Bob.
     vector<int> perm_alice(n_pow2);
     if (P.my_num() == alice)
@@ -125,9 +148,10 @@ void SecureShuffle<T>::inverse_permutation(vector<T> &stack, size_t n, size_t ou
     configure(alice, &perm_alice, n);
     // Apply perm_alice to perm_alice to get perm_bob,
     // stack permutation that we can reveal to Bob without Bob learning anything about perm_alice (since it is masked by perm_a)
-    iter_waksman(true);
+    tuples[0].config = &config;
+    iter_waksman(tuples);
     // Store perm_bob at stack[output_base]
-    post(stack, n, output_base);
+    post(tuples, stack);
 
     // Reveal permutation perm_bob = perm_a * perm_alice
     // Since this permutation is masked by perm_a, Bob learns nothing about perm
@@ -165,27 +189,35 @@ void SecureShuffle<T>::inverse_permutation(vector<T> &stack, size_t n, size_t ou
         stack[output_base + i] = input.finalize(alice);
 
     // The two parties now jointly compute perm_a * perm_bob_inv to obtain perm_inv
-    pre(stack, n, output_base);
+    tuples.clear();
+    tuples.push_back({n, 1, output_base, output_base, true});
+    pre(tuples[0], stack);
     configure(bob, &perm_bob_inv, n);
-    iter_waksman(true);
+    tuples[0].config = &config;
+    iter_waksman(tuples);
     // perm_inv is written back to stack[output_base]
-    post(stack, n, output_base);
+    post(tuples, stack);
 }
 
 template<class T>
-void SecureShuffle<T>::pre(vector<T>& a, size_t n, size_t input_base)
+void SecureShuffle<T>::pre(ShuffleTuple<T>& tuple, vector<T>& a)
 {
-    n_shuffle = n / unit_size;
+    size_t n = tuple.n;
+    int unit_size = tuple.unit_size;
+    auto& to_shuffle = tuple.to_shuffle;
+    size_t n_shuffle = n / unit_size;
     assert(unit_size * n_shuffle == n);
     size_t n_shuffle_pow2 = (1u << int(ceil(log2(n_shuffle))));
-    exact = (n_shuffle_pow2 == n_shuffle) or not T::malicious;
+    bool exact = (n_shuffle_pow2 == n_shuffle) or not T::malicious;
+    tuple.n_shuffle = n_shuffle;
+    tuple.exact = exact;
     to_shuffle.clear();
 
     if (exact)
     {
         to_shuffle.resize(n_shuffle_pow2 * unit_size);
         for (size_t i = 0; i < n; i++)
-            to_shuffle[i] = a[input_base + i];
+            to_shuffle[i] = a[tuple.input_base + i];
     }
     else
     {
@@ -194,45 +226,65 @@ void SecureShuffle<T>::pre(vector<T>& a, size_t n, size_t input_base)
         for (size_t i = 0; i < n_shuffle; i++)
         {
             for (int j = 0; j < unit_size; j++)
-                to_shuffle[i * (unit_size + 1) + j] = a[input_base
+                to_shuffle[i * (unit_size + 1) + j] = a[tuple.input_base
                         + i * unit_size + j];
             to_shuffle[i * (unit_size + 1) + unit_size] = T::constant(1,
                     proc.P.my_num(), proc.MC.get_alphai());
         }
-        this->unit_size++;
+        tuple.shuffle_unit_size = unit_size + 1;
     }
 }
 
 template<class T>
-void SecureShuffle<T>::post(vector<T>& a, size_t n, size_t output_base)
+void SecureShuffle<T>::post(vector<ShuffleTuple<T>>& tuples, vector<T>& a)
 {
-    if (exact)
-        for (size_t i = 0; i < n; i++)
-            a[output_base + i] = to_shuffle[i];
-    else
+    // indicator bits of all inexact shuffles are opened together
+    auto& MC = proc.MC;
+    bool any_inexact = false;
+    for (auto& tuple : tuples)
+        any_inexact |= not tuple.exact;
+
+    if (any_inexact)
     {
-        auto& MC = proc.MC;
         MC.init_open(proc.P);
-        int shuffle_unit_size = this->unit_size;
-        int unit_size = shuffle_unit_size - 1;
-        for (size_t i = 0; i < to_shuffle.size() / shuffle_unit_size; i++)
-            MC.prepare_open(to_shuffle.at((i + 1) * shuffle_unit_size - 1));
+        for (auto& tuple : tuples)
+            if (not tuple.exact)
+            {
+                int shuffle_unit_size = tuple.shuffle_unit_size;
+                for (int i = 0; i < tuple.n_elements(); i++)
+                    MC.prepare_open(
+                            tuple.to_shuffle.at((i + 1) * shuffle_unit_size - 1));
+            }
         MC.exchange(proc.P);
-        size_t i_shuffle = 0;
-        for (size_t i = 0; i < n_shuffle; i++)
+    }
+
+    for (auto& tuple : tuples)
+    {
+        auto& to_shuffle = tuple.to_shuffle;
+        size_t output_base = tuple.output_base;
+        if (tuple.exact)
+            for (size_t i = 0; i < tuple.n; i++)
+                a[output_base + i] = to_shuffle[i];
+        else
         {
-            auto bit = MC.finalize_open();
-            if (bit == 1)
+            int shuffle_unit_size = tuple.shuffle_unit_size;
+            int unit_size = tuple.unit_size;
+            size_t i_shuffle = 0;
+            for (int i = 0; i < tuple.n_elements(); i++)
             {
-                // only output real elements
-                for (int j = 0; j < unit_size; j++)
-                    a.at(output_base + i_shuffle * unit_size + j) =
-                            to_shuffle.at(i * shuffle_unit_size + j);
-                i_shuffle++;
+                auto bit = MC.finalize_open();
+                if (bit == 1)
+                {
+                    // only output real elements
+                    for (int j = 0; j < unit_size; j++)
+                        a.at(output_base + i_shuffle * unit_size + j) =
+                                to_shuffle.at(i * shuffle_unit_size + j);
+                    i_shuffle++;
+                }
             }
+            if (i_shuffle != tuple.n_shuffle)
+                throw runtime_error("incorrect shuffle");
         }
-        if (i_shuffle != n_shuffle)
-            throw runtime_error("incorrect shuffle");
     }
 }
 
@@ -253,12 +305,16 @@ vector<int> SecureShuffle<T>::generate_random_permutation(int n) {
 }
 
 template<class T>
-void SecureShuffle<T>::player_round(int config_player) {
-    vector<int> random_perm(n_shuffle);
+void SecureShuffle<T>::player_round(vector<ShuffleTuple<T>>& tuples,
+        int config_player)
+{
+    auto& tuple = tuples.at(0);
+    vector<int> random_perm(tuple.n_shuffle);
     if (proc.P.my_num() == config_player)
-        random_perm = generate_random_permutation(n_shuffle);
-    configure(config_player, &random_perm, n_shuffle);
-    iter_waksman();
+        random_perm = generate_random_permutation(tuple.n_shuffle);
+    configure(config_player, &random_perm, tuple.n_shuffle);
+    tuple.config = &config;
+    iter_waksman(tuples);
 }
 
 template<class T>
@@ -383,66 +439,118 @@ void SecureShuffle<T>::cond_swap(T& x, T& y, const T& b)
 }
 
 template<class T>
-void SecureShuffle<T>::iter_waksman(bool reverse)
+void SecureShuffle<T>::iter_waksman(vector<ShuffleTuple<T>>& tuples)
 {
-    int n = to_shuffle.size() / unit_size;
+    int n_layers = 0;
+    for (auto& tuple : tuples)
+        n_layers = max(n_layers, tuple.n_layers());
 
-    for (int depth = 0; depth < log2(n); depth++)
-        waksman_round(depth, true, reverse);
-
-    for (int depth = log2(n) - 2; depth >= 0; depth--)
-        waksman_round(depth, false, reverse);
+    for (int layer = 0; layer < n_layers; layer++)
+        waksman_round(tuples, layer);
 }
 
 template<class T>
-void SecureShuffle<T>::waksman_round(int depth, bool inwards, bool reverse)
+void SecureShuffle<T>::waksman_round(vector<ShuffleTuple<T>>& tuples,
+        int layer)
 {
-    int n = to_shuffle.size() / unit_size;
-    assert((int) config.at(depth).size() == n);
-    int nblocks = 1 << depth;
-    int size = n / (2 * nblocks);
-    bool outwards = !inwards;
-    proc.protocol.init_mul();
-    vector<array<int, 5>> indices;
-    indices.reserve(n / 2);
-    Waksman waksman(n);
-    for (int k = 0; k < n / 2; k++)
+    vector<pair<T, T>> multiplicands;
+    vector<vector<array<int, 5>>> indices(tuples.size());
+
+    for (size_t i_tuple = 0; i_tuple < tuples.size(); i_tuple++)
     {
-        int j = k % size;
-        int i = k / size;
-        int base = 2 * i * size;
-        int in1 = base + j + j * inwards;
-        int in2 = in1 + inwards + size * outwards;
-        int out1 = base + j + j * outwards;
-        int out2 = out1 + outwards + size * inwards;
-        int i_bit = base + j + size * (outwards ^ reverse);
-        bool run = waksman.matters(depth, i_bit);
-        if (run)
+        auto& tuple = tuples[i_tuple];
+        if (layer >= tuple.n_layers())
+            continue;
+
+        // smaller networks finish earlier
+        int n = tuple.n_elements();
+        int logn = log2(n);
+        bool inwards = layer < logn;
+        bool outwards = !inwards;
+        int depth = inwards ? layer : 2 * logn - 2 - layer;
+        auto& config = tuple.config->at(depth);
+        assert((int) config.size() == n);
+        int nblocks = 1 << depth;
+        int size = n / (2 * nblocks);
+        int unit_size = tuple.shuffle_unit_size;
+        auto& to_shuffle = tuple.to_shuffle;
+        auto& tuple_indices = indices[i_tuple];
+        tuple_indices.reserve(n / 2);
+        Waksman waksman(n);
+        for (int k = 0; k < n / 2; k++)
         {
-            for (int l = 0; l < unit_size; l++)
-                proc.protocol.prepare_mul(config.at(depth).at(i_bit),
+            int j = k % size;
+            int i = k / size;
+            int base = 2 * i * size;
+            int in1 = base + j + j * inwards;
+            int in2 = in1 + inwards + size * outwards;
+            int out1 = base + j + j * outwards;
+            int out2 = out1 + outwards + size * inwards;
+            int i_bit = base + j + size * (outwards ^ tuple.reverse);
+            bool run = waksman.matters(depth, i_bit);
+            if (run)
+            {
+                for (int l = 0; l < unit_size; l++)
+                    multiplicands.push_back({config.at(i_bit),
                         to_shuffle.at(in1 * unit_size + l)
-                                - to_shuffle.at(in2 * unit_size + l));
+                                - to_shuffle.at(in2 * unit_size + l)});
+            }
+            tuple_indices.push_back({{in1, in2, out1, out2, run}});
         }
-        indices.push_back({{in1, in2, out1, out2, run}});
     }
-    proc.protocol.exchange();
-    tmp.resize(to_shuffle.size());
-    for (int k = 0; k < n / 2; k++)
+
+    PointerVector<T> products(multiplicands.size());
+    multiply(products, multiplicands);
+
+    vector<T> tmp;
+    for (size_t i_tuple = 0; i_tuple < tuples.size(); i_tuple++)
     {
-        auto idx = indices.at(k);
-        for (int l = 0; l < unit_size; l++)
+        auto& tuple = tuples[i_tuple];
+        if (layer >= tuple.n_layers())
+            continue;
+
+        int unit_size = tuple.shuffle_unit_size;
+        auto& to_shuffle = tuple.to_shuffle;
+        tmp.resize(to_shuffle.size());
+        for (auto& idx : indices[i_tuple])
         {
-            T diff;
-            if (idx[4])
-                diff = proc.protocol.finalize_mul();
-            tmp.at(idx[2] * unit_size + l) = to_shuffle.at(
-                    idx[0] * unit_size + l) - diff;
-            tmp.at(idx[3] * unit_size + l) = to_shuffle.at(
-                    idx[1] * unit_size + l) + diff;
+            for (int l = 0; l < unit_size; l++)
+            {
+                T diff;
+                if (idx[4])
+                    diff = products.next();
+                tmp.at(idx[2] * unit_size + l) = to_shuffle.at(
+                        idx[0] * unit_size + l) - diff;
+                tmp.at(idx[3] * unit_size + l) = to_shuffle.at(
+                        idx[1] * unit_size + l) + diff;
+            }
         }
+        swap(tmp, to_shuffle);
+    }
+}
+
+template<class T>
+void SecureShuffle<T>::multiply(PointerVector<T>& products,
+        vector<pair<T, T>>& multiplicands)
+{
+    // idle threads take a share of the conditional swaps,
+    // which requires them to run the same protocol
+    // and their own preprocessing to be available
+    if (BaseMachine::thread_num == 0 and BaseMachine::has_singleton()
+            and not T::clear::characteristic_two
+            and OnlineOptions::singleton.live_prep)
+    {
+        auto& queues = BaseMachine::s().queues;
+        ThreadJob job(&products, &multiplicands);
+        int start = queues.distribute(job, multiplicands.size());
+        proc.protocol.multiply(products, multiplicands, start,
+                multiplicands.size(), proc);
+        if (start)
+            queues.wrap_up(job);
     }
-    swap(tmp, to_shuffle);
+    else
+        proc.protocol.multiply(products, multiplicands, 0,
+                multiplicands.size(), proc);
 }
 
 #endif /* PROTOCOLS_SECURESHUFFLE_HPP_ */
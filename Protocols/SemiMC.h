@@ -48,6 +48,7 @@ public:
     { POpen_(values, S, P); }
     void POpen_Begin(vector<typename T::open_type>& values,const vector<T>& S,const Player& P);
     void POpen_End(vector<typename T::open_type>& values,const vector<T>& S,const Player& P);
+    bool pipelines_open() { return true; }
 
     void exchange(const Player& P) { exchange_(P); }
     void exchange_(const PlayerBase& P);
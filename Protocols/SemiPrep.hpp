@@ -49,7 +49,7 @@ void SemiPrep<T>::buffer_dabits(ThreadQueues* queues)
     {
         assert(this->triple_generator);
         this->triple_generator->set_batch_size(
-                BaseMachine::batch_size<T>(DATA_DABIT, this->buffer_size));
+                BaseMachine::batch_size<T>(DATA_DABIT, this->dabit_buffer_size()));
         this->triple_generator->generatePlainBits();
         for (auto& x : this->triple_generator->plainBits)
             this->dabits.push_back({x.first, x.second});
@@ -77,6 +77,7 @@ public:
     const static bool dishonest_majority = true;
     const static bool variable_players = true;
     const static bool expensive = false;
+    const static bool background_prep = true;
     static const bool has_trunc_pr = true;
     static const bool malicious = false;
 
@@ -10,6 +10,7 @@
 using namespace std;
 
 #include "Replicated.h"
+#include "Math/DotProduct.h"
 
 template<class T> class SubProcessor;
 template<class T> class ShamirMC;
@@ -36,7 +37,7 @@ class Shamir : public ProtocolBase<T>
 
     map<int, vector<vector<typename T::open_type>>> hypers;
 
-    typename T::open_type dotprod_share;
+    DotProduct<typename T::open_type> dotprod;
 
     void buffer_random();
 
@@ -68,6 +69,7 @@ public:
     void exchange();
     void start_exchange();
     void stop_exchange();
+    bool pipelines_exchange() { return true; }
 
     T finalize_mul(int n = -1);
 
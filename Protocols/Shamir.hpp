@@ -151,21 +151,22 @@ template<class T>
 void Shamir<T>::init_dotprod()
 {
     init_mul();
-    dotprod_share = 0;
+    dotprod = {};
 }
 
 template<class T>
 void Shamir<T>::prepare_dotprod(const T& x, const T& y)
 {
-    dotprod_share += x * y * rec_factor;
+    dotprod.add(x, y);
 }
 
 template<class T>
 void Shamir<T>::next_dotprod()
 {
+    // apply the reconstruction factor once per dot product
+    auto dotprod_share = dotprod.get() * rec_factor;
     if (P.my_num() < n_mul_players)
         resharing->add_mine(dotprod_share);
-    dotprod_share = 0;
 }
 
 template<class T>
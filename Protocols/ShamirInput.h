@@ -22,6 +22,7 @@ protected:
     Player& P;
     octetStreams os;
     vector<bool> senders;
+    deque<pair<PointerVector<T>, vector<bool>>> pending;
 
 public:
     IndividualInput(SubProcessor<T>* proc, Player& P) :
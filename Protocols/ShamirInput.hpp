@@ -135,17 +135,23 @@ void IndividualInput<T>::start_exchange()
     if (senders[P.my_num()])
         for (int offset = 1; offset < P.num_players(); offset++)
             P.send_relative(offset, os[P.get_player(offset)]);
+    // keep own shares and senders until the round is stopped
+    pending.push_back({move(this->shares), senders});
 }
 
 template<class T>
 void IndividualInput<T>::stop_exchange()
 {
+    assert(not pending.empty());
+    auto& round_senders = pending.front().second;
     for (int offset = 1; offset < P.num_players(); offset++)
     {
         int receive_from = P.get_player(-offset);
-        if (senders[receive_from])
+        if (round_senders[receive_from])
             P.receive_player(receive_from, InputBase<T>::os[receive_from]);
     }
+    this->shares = move(pending.front().first);
+    pending.pop_front();
 }
 
 template<class T>
@@ -7,6 +7,7 @@
 #define PROTOCOLS_SHAMIRMC_H_
 
 #include "MAC_Check_Base.h"
+#include "MAC_Check.h"
 #include "Protocols/ShamirShare.h"
 #include "Machines/ShamirMachine.h"
 #include "Tools/Bundle.h"
@@ -28,7 +29,10 @@ public:
 };
 
 /**
- * Shamir secret sharing opening protocol (direct communication)
+ * Shamir secret sharing opening protocol (direct communication).
+ * With many parties or values, parties 0 to threshold
+ * contribute their shares multiplied by the reconstruction factors
+ * to an all-reduce instead (see TreeSum).
  */
 template<class T>
 class ShamirMC : public IndirectShamirMC<T>
@@ -37,6 +41,10 @@ class ShamirMC : public IndirectShamirMC<T>
     typedef typename T::open_type::Scalar rec_type;
     vector<typename T::open_type::Scalar> reconstruction;
 
+    TreeSum<open_type> tree_sum;
+    vector<open_type> summed;
+    size_t n_summed;
+
     ShamirMC(const ShamirMC&);
 
     void finalize(vector<typename T::open_type>& values, const vector<T>& S);
@@ -47,6 +55,7 @@ protected:
     int threshold;
 
     void prepare(const vector<T>& S, const Player& P);
+    void direct_exchange(const Player& P);
 
 public:
     ShamirMC(int threshold = 0);
@@ -10,7 +10,7 @@
 
 template<class T>
 ShamirMC<T>::ShamirMC(int t) :
-        os(0), player(0), threshold()
+        n_summed(0), os(0), player(0), threshold()
 {
     if (t > 0)
         threshold = t;
@@ -62,6 +62,8 @@ void ShamirMC<T>::init_open(const Player& P, int n)
         o.reset_write_head();
     os->mine.reserve(n * T::size());
     this->player = &P;
+    summed.clear();
+    n_summed = 0;
 }
 
 template<class T>
@@ -89,6 +91,35 @@ void ShamirMC<T>::POpen(vector<typename T::open_type>& values, const vector<T>&
 
 template<class T>
 void ShamirMC<T>::exchange(const Player& P)
+{
+    typedef TreeSum<open_type> sum_type;
+    auto& mine = os->mine;
+    // sending to threshold parties in one round
+    auto schedule = sum_type::schedule(mine.get_length() / open_type::size(),
+            P.num_players(), 1, threshold);
+    if (schedule == sum_type::BASELINE)
+        return direct_exchange(P);
+
+    summed.clear();
+    mine.reset_read_head();
+    if (P.my_num() <= threshold)
+    {
+        auto rec_factor = Shamir<T>::get_rec_factor(P.my_num(), threshold + 1);
+        while (mine.left())
+            summed.push_back(mine.get<open_type>() * rec_factor);
+    }
+    else
+        while (mine.left())
+        {
+            mine.get<open_type>();
+            summed.push_back({});
+        }
+    tree_sum.run(summed, P, schedule);
+    n_summed = 0;
+}
+
+template<class T>
+void ShamirMC<T>::direct_exchange(const Player& P)
 {
     vector<bool> my_senders(P.num_players()), my_receivers(P.num_players());
     for (int i = 0; i < P.num_players(); i++)
@@ -119,6 +150,9 @@ void ShamirMC<T>::finalize(vector<typename T::open_type>& values,
 template<class T>
 typename T::open_type ShamirMC<T>::finalize_raw()
 {
+    if (not summed.empty())
+        return summed.at(n_summed++);
+
     assert(reconstruction.size());
     typename T::open_type res;
     for (size_t j = 0; j < reconstruction.size(); j++)
@@ -179,6 +179,7 @@ public:
     typedef MascotTriplePrep<Share> TriplePrep;
 
     static const bool expensive = true;
+    static const bool background_prep = true;
 
     static string type_short()
       { return string(1, T::type_char()); }
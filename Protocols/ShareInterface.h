@@ -36,6 +36,8 @@ public:
     static const bool needs_ot = false;
     static const bool expensive = false;
     static const bool expensive_triples = false;
+    // live preprocessing in the background (--async-preprocessing)
+    static const bool background_prep = false;
 
     static const bool has_trunc_pr = false;
     static const bool has_split = false;
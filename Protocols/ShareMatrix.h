@@ -11,6 +11,7 @@ using namespace std;
 
 #include "Share.h"
 #include "FHE/AddableVector.h"
+#include "Math/DotProduct.h"
 
 template<class T> class MatrixMC;
 
@@ -205,10 +206,14 @@ public:
         if (entries.v.empty() or other.entries.v.empty())
             return res;
         res.entries.init();
+        DotProduct<T> dotprod;
         for (int i = 0; i < n_rows; i++)
             for (int j = 0; j < other.n_cols; j++)
+            {
                 for (int k = 0; k < n_cols; k++)
-                    res[{i, j}] += (*this)[{i, k}] * other[{k, j}];
+                    dotprod.add((*this)[{i, k}], other[{k, j}]);
+                res[{i, j}] = dotprod.get();
+            }
         res.check();
         return res;
     }
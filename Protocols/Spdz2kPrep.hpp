@@ -130,7 +130,7 @@ void Spdz2kPrep<T>::buffer_dabits(ThreadQueues* queues)
 {
     assert(this->proc != 0);
     vector<dabit<T>> check_dabits;
-    int buffer_size = BaseMachine::batch_size<T>(DATA_DABIT, this->buffer_size);
+    int buffer_size = BaseMachine::batch_size<T>(DATA_DABIT, this->dabit_buffer_size());
     this->buffer_dabits_from_bits_without_check(check_dabits,
             dabit_sacrifice.minimum_n_inputs(buffer_size), queues);
     dabit_sacrifice.sacrifice_without_bit_check(this->dabits, check_dabits,
@@ -0,0 +1,43 @@
+# functions for tests with programs printing "expected X, got Y",
+# to be sourced from Scripts/test_*.sh
+
+# run_expected <protocol> <program> <number of results> [run options]
+# runs Scripts/<protocol>.sh and checks the number of results and that
+# every result is as expected, in the output of party $result_party
+# if given or the first party otherwise
+run_expected()
+{
+    local protocol=$1 program=$2 n_results=$3 out
+    shift 3
+    out=/tmp/$program-$protocol$(echo $* | tr -d ' ')
+    if ! Scripts/$protocol.sh $program $* > $out.log 2>&1; then
+	cat $out.log
+	echo "$program failed with $protocol $*"
+	exit 1
+    fi
+    if test "$result_party"; then
+	grep expected logs/$program-$result_party > $out
+    else
+	grep expected $out.log > $out
+    fi
+    if test $(wc -l < $out) != $n_results; then
+	cat $out.log
+	echo "$program with $protocol $*: $(wc -l < $out) results" \
+	     "instead of $n_results"
+	exit 1
+    fi
+    if grep -v 'expected \(.*\), got \1$' $out; then
+	echo "$program with $protocol $*: wrong results"
+	exit 1
+    fi
+}
+
+# run_expected_all "<protocols>" <program> <number of results> [run options]
+run_expected_all()
+{
+    local protocols=$1 protocol
+    shift
+    for protocol in $protocols; do
+	run_expected $protocol $*
+    done
+}
@@ -0,0 +1,26 @@
+#!/bin/bash
+
+# all schedules of --all-reduce with additive and Shamir secret sharing,
+# including five parties, which is not a power of two; Shamir only uses
+# them with --direct
+
+. Scripts/test-common.sh
+
+# certificates for five parties, regenerated if P4 is older than the rest
+test Player-Data/P4.pem -nt Player-Data/P0.pem || Scripts/setup-ssl.sh 5
+
+make semi2k-party.x shamir-party.x || exit 1
+
+./compile.py -R 64 test_all_reduce || exit 1
+for players in 2 3 5; do
+    for schedule in butterfly ring off; do
+	PLAYERS=$players run_expected semi2k test_all_reduce 3 \
+	       --all-reduce $schedule
+    done
+done
+
+./compile.py test_all_reduce || exit 1
+for schedule in butterfly ring off; do
+    PLAYERS=5 run_expected shamir test_all_reduce 3 --direct \
+	   --all-reduce $schedule
+done
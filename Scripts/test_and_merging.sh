@@ -0,0 +1,17 @@
+#!/bin/bash
+
+# binary circuits with and without merging AND instructions at run time
+# must give the same (correct) results
+
+. Scripts/test-common.sh
+
+make replicated-bin-party.x yao-party.x semi-bin-party.x || exit 1
+./compile.py -n test_and_merging || exit 1
+
+for protocol in replicated yao semi-bin; do
+    for opt in "" --no-and-merging; do
+	run_expected $protocol test_and_merging 4 $opt
+    done
+
+    diff /tmp/test_and_merging-$protocol{,--no-and-merging} || exit 1
+done
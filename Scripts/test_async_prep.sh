@@ -0,0 +1,26 @@
+#!/bin/bash
+
+# background preprocessing with a malicious and a semi-honest
+# dishonest-majority protocol
+
+. Scripts/test-common.sh
+
+make mascot-party.x spdz2k-party.x semi2k-party.x || exit 1
+
+check_used()
+{
+    if grep -q 'ignoring --async-preprocessing' $1; then
+	echo "background preprocessing not used in $1"
+	exit 1
+    fi
+}
+
+./compile.py -F 128 test_async_prep || exit 1
+run_expected mascot test_async_prep 4 --async-preprocessing
+check_used /tmp/test_async_prep-mascot--async-preprocessing.log
+
+./compile.py -R 64 test_async_prep || exit 1
+for protocol in spdz2k semi2k; do
+    run_expected $protocol test_async_prep 4 --async-preprocessing
+    check_used /tmp/test_async_prep-$protocol--async-preprocessing.log
+done
@@ -0,0 +1,13 @@
+#!/bin/bash
+
+# BMR with the SPDZ backend on the binary circuit tests
+
+. Scripts/test-common.sh
+
+make real-bmr-party.x || exit 1
+
+./compile.py test_gc || exit 1
+run_expected real-bmr test_gc 77
+
+./compile.py -n test_and_merging || exit 1
+run_expected real-bmr test_and_merging 4
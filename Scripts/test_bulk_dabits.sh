@@ -0,0 +1,12 @@
+#!/bin/bash
+
+# long vectors of daBits and edaBits with a batch size below their
+# length, so they are generated in one bulk batch
+
+. Scripts/test-common.sh
+
+make semi2k-party.x replicated-ring-party.x || exit 1
+./compile.py -R 64 test_bulk_dabits || exit 1
+
+run_expected_all "semi2k ring" test_bulk_dabits 4 -b 100
+run_expected semi2k test_bulk_dabits 4 -b 100 --adaptive-batch 1
@@ -0,0 +1,13 @@
+#!/bin/bash
+
+# the native circuit instruction must give the same results as the
+# circuit compiled per gate, in and out of the register width
+
+. Scripts/test-common.sh
+
+# the circuits are fetched once for all scripts
+test -e Programs/Circuits/aes_128.txt || make Programs/Circuits || exit 1
+make replicated-bin-party.x yao-party.x || exit 1
+./compile.py test_circuit_native || exit 1
+
+run_expected_all "replicated yao" test_circuit_native 40
@@ -0,0 +1,65 @@
+#!/bin/bash
+
+# MAC check with honest and tampered preprocessing, the latter in a
+# share and in a MAC of a triple in the middle of those used, for
+# MASCOT with both ways of combining values and for SPDZ2k
+
+. Scripts/test-common.sh
+
+make Fake-Offline.x mascot-party.x spdz2k-party.x || exit 1
+
+# 2000 triples of 96 bytes (three shares followed by their MACs),
+# of which the program uses about 1000 from the start
+# the online phase removes what it uses, so every run needs new ones
+fake()
+{
+    ./Fake-Offline.x 2 $fake_options --default 2000 > /dev/null || exit 1
+}
+
+# flip the lowest bit of the share or MAC of the first element of the
+# 500th triple in $triples
+flip()
+{
+    local offset=$(( $(wc -c < $triples) - 96 * 1500 + $1 )) byte
+    byte=$(od -An -tu1 -j$offset -N1 $triples)
+    printf "\\$(printf %o $(( byte ^ 1 )))" |
+	dd of=$triples bs=1 seek=$offset conv=notrunc 2> /dev/null
+}
+
+# run_tampered <protocol> <offset in share> [run options]
+run_tampered()
+{
+    local protocol=$1 offset=$2 out
+    shift 2
+    out=/tmp/test_mac_check-$protocol-$offset$(echo $* | tr -d ' ')
+    fake
+    flip $offset
+    if Scripts/$protocol.sh test_mac_check -F $* > $out.log 2>&1 ||
+	    ! grep -q 'MacCheck Failure' $out.log; then
+	cat $out.log
+	echo "tampering at $offset not detected with $protocol $*"
+	exit 1
+    fi
+}
+
+# run_all <protocol> [run options]
+run_all()
+{
+    fake
+    run_expected $1 test_mac_check 2 -F ${@:2}
+    # share and MAC
+    for offset in 0 16; do
+	run_tampered $1 $offset ${@:2}
+    done
+}
+
+fake_options="-lgp 128"
+triples=Player-Data/2-p-128/Triples-p-P1
+./compile.py -F 128 test_mac_check || exit 1
+run_all mascot
+run_all mascot --hash-chain-check
+
+fake_options="-Z 64 -S 64"
+triples=Player-Data/2-Z64,64-64/Triples-Z64,64-P1
+./compile.py -R 64 test_mac_check || exit 1
+run_all spdz2k
@@ -0,0 +1,18 @@
+#!/bin/bash
+
+# live preprocessing with OT extension split among threads per pair of
+# parties and with larger SoftSpokenOT fields (only without USE_KOS,
+# which ignores --ot-threads and --soft-spoken)
+
+. Scripts/test-common.sh
+
+make mascot-party.x spdz2k-party.x semi2k-party.x || exit 1
+
+./compile.py -F 128 test_ot_threads || exit 1
+run_expected mascot test_ot_threads 3 --ot-threads 3
+run_expected mascot test_ot_threads 3 --soft-spoken 8
+
+./compile.py -R 64 test_ot_threads || exit 1
+run_expected_all "spdz2k semi2k" test_ot_threads 3 --ot-threads 3
+run_expected_all "spdz2k semi2k" test_ot_threads 3 --ot-threads 2 \
+    --soft-spoken 4
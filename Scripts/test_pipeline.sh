@@ -0,0 +1,14 @@
+#!/bin/bash
+
+# multiplication with --pipeline in the protocols supporting it
+
+. Scripts/test-common.sh
+
+make replicated-ring-party.x semi2k-party.x shamir-party.x || exit 1
+
+./compile.py -R 64 test_pipeline || exit 1
+run_expected ring test_pipeline 3 --pipeline
+run_expected semi2k test_pipeline 3 --pipeline --direct
+
+./compile.py test_pipeline || exit 1
+run_expected shamir test_pipeline 3 --pipeline
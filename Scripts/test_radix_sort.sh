@@ -0,0 +1,10 @@
+#!/bin/bash
+
+# radix sort instruction with a semi-honest and a malicious protocol
+
+. Scripts/test-common.sh
+
+make semi2k-party.x malicious-rep-ring-party.x || exit 1
+./compile.py -R 64 test_radix_sort || exit 1
+
+run_expected_all "semi2k mal-rep-ring" test_radix_sort 100
@@ -0,0 +1,12 @@
+#!/bin/bash
+
+# several shuffle applications merged into one instruction,
+# semi-honest and malicious (indicator bits for lengths other than powers of two),
+# in threads and with resharing distributed among threads
+
+. Scripts/test-common.sh
+
+make semi2k-party.x malicious-rep-ring-party.x replicated-ring-party.x || exit 1
+./compile.py -R 64 test_shuffle_merging || exit 1
+
+run_expected_all "semi2k ring mal-rep-ring" test_shuffle_merging 58
@@ -0,0 +1,26 @@
+#!/bin/bash
+
+# Yao's garbled circuits with three-halves garbling (-DTHREE_HALVES_GATES)
+# on the binary circuit tests, using a separately built binary
+
+. Scripts/test-common.sh
+
+# the circuits are fetched once for all scripts
+test -e Programs/Circuits/aes_128.txt || make Programs/Circuits || exit 1
+
+make yao-three-halves-party.x || exit 1
+
+./compile.py test_gc || exit 1
+run_expected yao-three-halves test_gc 77
+
+./compile.py aes_circuit || exit 1
+# AES-128 test vector from NIST SP 800-38A, F.1.1
+Scripts/yao-three-halves.sh aes_circuit |
+    grep '= 0x3ad77bb40d7a3660a89ecaf32466ef97' || exit 1
+
+./compile.py test_yao_chunks || exit 1
+echo 65535 > Player-Data/Input-P0-0
+echo 32767 > Player-Data/Input-P1-0
+run_expected yao-three-halves test_yao_chunks 1 -b 10000000
+
+exit 0
@@ -0,0 +1,18 @@
+#!/bin/bash
+
+# the evaluator needs its input in the middle of a round
+# with several megabytes of garbled gates before and after
+
+. Scripts/test-common.sh
+
+make yao-party.x || exit 1
+./compile.py test_yao_chunks || exit 1
+
+echo 65535 > Player-Data/Input-P0-0
+echo 32767 > Player-Data/Input-P1-0
+
+run_expected yao test_yao_chunks 1 -b 10000000
+# one-shot with the whole garbled circuit in a memory-mapped file,
+# where only the evaluator has the output
+result_party=1 run_expected yao test_yao_chunks 1 -b 10000000 -O \
+	     --garbled-memory 0
@@ -0,0 +1,13 @@
+#!/bin/bash
+
+# garbling and evaluation with several worker threads,
+# independent of the number of cores
+
+. Scripts/test-common.sh
+
+make yao-party.x || exit 1
+./compile.py test_yao_threads || exit 1
+
+for threads in 1 2 3 4; do
+    run_expected yao test_yao_threads 2 --worker-threads $threads
+done
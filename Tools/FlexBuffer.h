@@ -22,10 +22,12 @@ class FlexBuffer
 protected:
     char* buf, *ptr;
 	size_t len, max_len;
+	// memory not owned by the buffer (see ReceivedMsg::borrow())
+	bool borrowed;
 	void del();
-	void reset() { buf = ptr = 0; len = max_len = 0; }
+	void reset() { buf = ptr = 0; len = max_len = 0; borrowed = false; }
 public:
-	FlexBuffer() : buf(0), ptr(0), len(0), max_len(0) {}
+	FlexBuffer() : buf(0), ptr(0), len(0), max_len(0), borrowed(false) {}
 	FlexBuffer(const FlexBuffer&);
 	~FlexBuffer() { del(); }
 	void operator=(FlexBuffer& msg);
@@ -44,6 +46,8 @@ public:
 	void operator=(FlexBuffer& msg) { FlexBuffer::operator=(msg); }
 	void reset_head() { ptr = buf; }
 	void resize(size_t new_len);
+	/// Read from external memory without copying or taking ownership
+	void borrow(const char* data, size_t len);
 	void unserialize(void* output, size_t size);
 	template <class T>
 	void unserialize(T& output);
@@ -114,6 +118,7 @@ inline void FlexBuffer::operator=(FlexBuffer& msg)
         ptr = msg.ptr;
         len = msg.len;
         max_len = msg.max_len;
+        borrowed = msg.borrowed;
 #ifdef DEBUG_FLEXBUF
         cout << "moved " << (void*)buf << " " << (void*)msg.buf << " from " << &msg << " to " << this << endl;
 #endif
@@ -146,12 +151,22 @@ inline void ReceivedMsg::resize(size_t new_len)
 	ptr = buf;
 }
 
+inline void ReceivedMsg::borrow(const char* data, size_t len)
+{
+	del();
+	buf = ptr = (char*) data;
+	this->len = len;
+	// any resizing allocates
+	max_len = 0;
+	borrowed = true;
+}
+
 inline void FlexBuffer::del()
 {
 #ifdef DEBUG_FLEXBUF
 	printf("delete 0x%x for 0x%x\n", buf, this);
 #endif
-	if (buf)
+	if (buf and not borrowed)
 		delete[] buf;
 	reset();
 }
@@ -191,8 +206,10 @@ inline void SendBuffer::resize_copy(size_t new_max_len)
 	if (old)
 	{
 		avx_memcpy(buf, old, len);
-		delete[] old;
+		if (not borrowed)
+			delete[] old;
 	}
+	borrowed = false;
 	ptr = buf + (ptr - old);
 }
 
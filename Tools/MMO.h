@@ -49,10 +49,13 @@ public:
     template <int X, int L>
     void hashEightBlocks(gfpvar_<X, L>* output, const void* input);
     template <class T>
+    void hashManyBlocks(T* output, const void* input, int n);
+    template <class T>
     void outputOneBlock(octet* output);
     Key hash(const Key& input);
     template <int N>
     void hash(Key* output, const Key* input);
+    void hash(Key* output, const Key* input, int n);
 };
 
 template<int N>
@@ -85,4 +88,23 @@ inline void MMO::hash(Key* output, const Key* input)
     encrypt_and_xor<N>(&output->r, &input->r, IV[0]);
 }
 
+// output must not overlap with input
+inline void MMO::hash(Key* output, const Key* input, int n)
+{
+    // VAES only pays off with more than a few blocks
+    if (n >= 16 and n % 4 == 0 and cpu_has_vaes())
+    {
+        ecb_aes_128_encrypt_vaes(&output->r, &input->r, IV[0], n);
+        for (int i = 0; i < n; i++)
+            output[i] ^= input[i];
+        return;
+    }
+
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+        hash<8>(output + i, input + i);
+    for (; i < n; i++)
+        output[i] = hash(input[i]);
+}
+
 #endif /* TOOLS_MMO_H_ */
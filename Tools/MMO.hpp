@@ -124,6 +124,38 @@ void MMO::hashEightBlocks(__m128i* output, const void* input)
     hashBlocks<8, 16>(output, input, 16);
 }
 
+template <class T>
+void MMO::hashManyBlocks(T* output, const void* input, int n)
+{
+    assert(n % 8 == 0);
+    for (int i = 0; i < n; i += 8)
+        hashEightBlocks(output + i, (__m128i*) input + i);
+}
+
+template <>
+inline
+void MMO::hashManyBlocks(__m128i* output, const void* input, int n)
+{
+    // VAES only pays off with more than a few blocks
+    if (n >= 16 and n % 4 == 0 and cpu_has_vaes())
+    {
+        // OT extension hashes the receiver output in place
+        const int max_n = 128;
+        __m128i tmp[max_n];
+        for (int i = 0; i < n; i += max_n)
+        {
+            int m = min(n - i, max_n);
+            ecb_aes_128_encrypt_vaes(tmp, (__m128i*) input + i, IV[0], m);
+            for (int j = 0; j < m; j++)
+                output[i + j] = tmp[j]
+                        ^ _mm_loadu_si128((__m128i*) input + i + j);
+        }
+    }
+    else
+        for (int i = 0; i < n; i += 8)
+            hashEightBlocks(output + i, (__m128i*) input + i);
+}
+
 template<int X, int L>
 void MMO::hashEightBlocks(gfpvar_<X, L>* output, const void* input)
 {
@@ -225,3 +225,50 @@ void aes_256_encrypt(octet* out, const octet* in, const octet* key)
 
 
 
+
+#ifdef __x86_64__
+// four blocks per register, R registers interleaved
+template<int R>
+__attribute__((target("avx512f,vaes")))
+inline void ecb_aes_128_encrypt_avx512(__m128i* out, const __m128i* in,
+    const __m512i* keys)
+{
+  __m512i tmp[R];
+  for (int k = 0; k < R; k++)
+    tmp[k] = _mm512_xor_si512(_mm512_loadu_si512(in + 4 * k), keys[0]);
+  for (int j = 1; j < 10; j++)
+    for (int k = 0; k < R; k++)
+      tmp[k] = _mm512_aesenc_epi128(tmp[k], keys[j]);
+  for (int k = 0; k < R; k++)
+    _mm512_storeu_si512(out + 4 * k, _mm512_aesenclast_epi128(tmp[k], keys[10]));
+}
+
+__attribute__((target("avx512f,vaes")))
+static void ecb_aes_128_encrypt_avx512(__m128i* out, const __m128i* in,
+    const octet* key, int n)
+{
+  __m512i keys[11];
+  for (int j = 0; j < 11; j++)
+    keys[j] = _mm512_broadcast_i32x4(_mm_loadu_si128((__m128i*)key + j));
+  // more registers in parallel don't improve throughput
+  int i;
+  for (i = 0; i + 8 <= n; i += 8)
+    ecb_aes_128_encrypt_avx512<2>(out + i, in + i, keys);
+  if (i < n)
+    ecb_aes_128_encrypt_avx512<1>(out + i, in + i, keys);
+}
+#endif
+
+void ecb_aes_128_encrypt_vaes(__m128i* out, const __m128i* in,
+    const octet* key, int n)
+{
+#ifdef __x86_64__
+  if (cpu_has_vaes() and n % 4 == 0)
+    ecb_aes_128_encrypt_avx512(out, in, key, n);
+  else
+#endif
+    {
+      (void) out, (void) in, (void) key, (void) n;
+      throw runtime_error("need VAES support and multiple of four blocks");
+    }
+}
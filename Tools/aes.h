@@ -104,6 +104,10 @@ inline void ecb_aes_128_encrypt(__m128i* out, const __m128i* in, const octet* ke
         software_ecb_aes_128_encrypt<N>(out, in, (uint*) key);
 }
 
+// AES on four blocks per instruction, n has to be a multiple of four
+void ecb_aes_128_encrypt_vaes(__m128i* out, const __m128i* in,
+        const octet* key, int n);
+
 template <int N>
 inline void ecb_aes_128_encrypt(__m128i* out, const __m128i* in, const octet* key, const int* indices)
 {
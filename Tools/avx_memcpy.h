@@ -79,4 +79,30 @@ inline void avx_memzero(void* dest, size_t length)
 	}
 }
 
+inline void avx_memxor(void* dest, const void* x, const void* y,
+		size_t length)
+{
+	char* d = (char*)dest;
+	const char* a = (const char*)x, *b = (const char*)y;
+#ifdef __AVX512F__
+	for (; length >= 64; length -= 64, d += 64, a += 64, b += 64)
+		_mm512_storeu_si512(d,
+				_mm512_xor_si512(_mm512_loadu_si512(a), _mm512_loadu_si512(b)));
+#endif
+#ifdef __AVX2__
+	for (; length >= 32; length -= 32, d += 32, a += 32, b += 32)
+		_mm256_storeu_si256((__m256i*)d,
+				_mm256_xor_si256(_mm256_loadu_si256((__m256i*)a),
+						_mm256_loadu_si256((__m256i*)b)));
+#endif
+#ifdef __SSE2__
+	for (; length >= 16; length -= 16, d += 16, a += 16, b += 16)
+		_mm_storeu_si128((__m128i*)d,
+				_mm_xor_si128(_mm_loadu_si128((__m128i*)a),
+						_mm_loadu_si128((__m128i*)b)));
+#endif
+	for (; length > 0; length--)
+		*d++ = *a++ ^ *b++;
+}
+
 #endif /* TOOLS_AVX_MEMCPY_H_ */
@@ -76,4 +76,53 @@ inline bool cpu_has_aes()
 #endif
 }
 
+inline bool check_xcr0(int mask)
+{
+#ifdef __aarch64__
+    (void) mask;
+    throw std::runtime_error("only for x86");
+#else
+    // the OS has to save the extended register state
+    if (not check_cpu(1, true, 27))
+        return false;
+    int ax, dx;
+    __asm__ __volatile__ ("xgetbv": "=a" (ax), "=d" (dx): "c" (0));
+    return (ax & mask) == mask;
+#endif
+}
+
+// the following are only used with runtime dispatch
+
+inline bool cpu_has_avx512()
+{
+#ifdef __x86_64__
+    // AVX-512F and AVX-512BW, opmask and ZMM state
+    static bool res = check_cpu(7, false, 16) and check_cpu(7, false, 30)
+            and check_xcr0(0xe6);
+    return res;
+#else
+    return false;
+#endif
+}
+
+inline bool cpu_has_vpclmul()
+{
+#ifdef __x86_64__
+    static bool res = cpu_has_avx512() and check_cpu(7, true, 10);
+    return res;
+#else
+    return false;
+#endif
+}
+
+inline bool cpu_has_vaes()
+{
+#ifdef __x86_64__
+    static bool res = cpu_has_avx512() and check_cpu(7, true, 9);
+    return res;
+#else
+    return false;
+#endif
+}
+
 #endif /* TOOLS_CPU_SUPPORT_H_ */
@@ -72,6 +72,8 @@ octetStream::octetStream(const octetStream &os)
 
 octetStream::octetStream(FlexBuffer &buffer)
 {
+  if (buffer.borrowed)
+    throw runtime_error("cannot take ownership of borrowed buffer");
   mxlen = buffer.capacity();
   len = buffer.size();
   data = (octet *)buffer.data();
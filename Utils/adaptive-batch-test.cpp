@@ -0,0 +1,186 @@
+/*
+ * adaptive-batch-test.cpp
+ *
+ * Check the batch sizes of --adaptive-batch over several refills:
+ * geometric growth up to the memory cap without known consumption,
+ * sizing by what is left of the last run of a tape otherwise, and
+ * counting of refills requested with buffer_extra().
+ */
+
+#include "Protocols/SemiShare.h"
+#include "Protocols/SemiPrep.h"
+#include "Protocols/SemiInput.h"
+#include "Protocols/Semi.h"
+#include "Protocols/SemiMC.h"
+#include "GC/SemiSecret.h"
+#include "GC/SemiPrep.h"
+#include "Protocols/ReplicatedPrep.hpp"
+#include "Protocols/SemiPrep.hpp"
+#include "Protocols/Replicated.hpp"
+#include "Processor/Data_Files.hpp"
+#include "Math/Z2k.hpp"
+
+#include <sstream>
+using namespace std;
+
+typedef SemiShare<Z2<64>> T;
+
+class TestPrep : public BufferPrep<T>
+{
+    void buffer_triples()
+    {
+        int n = BaseMachine::batch_size<T>(DATA_TRIPLE, this->buffer_size);
+        batches.push_back(n);
+        this->triples.resize(this->triples.size() + n);
+    }
+
+    void buffer_bits()
+    {
+        int n = BaseMachine::batch_size<T>(DATA_BIT, this->buffer_size);
+        this->bits.resize(this->bits.size() + n);
+    }
+
+public:
+    vector<int> batches;
+
+    TestPrep(DataPositions& usage) :
+            BufferPrep<T>(usage)
+    {
+    }
+
+    void use_triples(int n, bool count = false)
+    {
+        T a, b, c;
+        for (int i = 0; i < n; i++)
+            if (count)
+                get_three(DATA_TRIPLE, a, b, c);
+            else
+                get_three_no_count(DATA_TRIPLE, a, b, c);
+    }
+
+    // triples left over from an earlier run
+    void leave_triples(int n)
+    {
+        this->triples.resize(n);
+    }
+
+    size_t n_triples_left()
+    {
+        return this->triples.size();
+    }
+
+    long long generated()
+    {
+        long long res = 0;
+        for (auto batch : batches)
+            res += batch;
+        return res;
+    }
+};
+
+bool check(const string& name, long long actual, long long expected)
+{
+    if (actual != expected)
+        cerr << name << ": expected " << expected << ", got " << actual
+                << endl;
+    return actual == expected;
+}
+
+int main()
+{
+    auto& opts = OnlineOptions::singleton;
+    opts.batch_size = 1000;
+    opts.adaptive_batch = 1;
+    bool ok = true;
+
+    DataPositions usage;
+    // 1 MB of triples
+    int cap = (1 << 20) / (3 * sizeof(T));
+
+    {
+        // no consumption known, doubling with every refill
+        TestPrep prep(usage);
+        prep.use_triples(100000);
+        vector<int> expected;
+        for (int i = 0, total = 0; total < 100000; i++)
+        {
+            expected.push_back(min(1000 << i, cap));
+            total += expected.back();
+        }
+        ok &= check("refills", prep.batches.size(), expected.size());
+        for (size_t i = 0; i < min(expected.size(), prep.batches.size()); i++)
+            ok &= check("refill " + to_string(i), prep.batches[i],
+                    expected[i]);
+    }
+
+    // consumption of the last run of the same tape
+    DataPositions last_run;
+    int n_triples = 2 * cap + 1;
+    last_run.files[DATA_INT][DATA_TRIPLE] = n_triples;
+
+    {
+        BaseMachine::start_tape(0);
+        BaseMachine::finish_tape(last_run);
+        usage.reset();
+        BaseMachine::start_tape(0, &usage);
+        TestPrep prep(usage);
+        prep.use_triples(n_triples, true);
+        ok &= check("refills with known consumption", prep.batches.size(), 3);
+        ok &= check("generated with known consumption", prep.generated(),
+                n_triples);
+        for (auto batch : prep.batches)
+            ok &= check("batch within cap", batch <= cap, true);
+        BaseMachine::finish_tape(last_run);
+    }
+
+    {
+        // only what is still needed after using the leftovers
+        usage.reset();
+        BaseMachine::start_tape(0, &usage);
+        TestPrep prep(usage);
+        prep.leave_triples(cap);
+        prep.use_triples(n_triples, true);
+        ok &= check("refills after leftovers", prep.batches.size(), 2);
+        ok &= check("generated after leftovers", prep.generated(),
+                n_triples - cap);
+        ok &= check("wasted after leftovers", prep.n_triples_left(), 0);
+        BaseMachine::finish_tape(last_run);
+    }
+
+    {
+        // refills by request are counted
+        opts.verbose = true;
+        stringstream ss;
+        auto buf = cerr.rdbuf(ss.rdbuf());
+        {
+            TestPrep prep(usage);
+            prep.buffer_extra(DATA_BIT, 123);
+            prep.buffer_extra(DATA_BIT, 456);
+        }
+        cerr.rdbuf(buf);
+        opts.verbose = false;
+        ok &= check("extra bits",
+                ss.str().find("2 refill rounds of Bits") != string::npos
+                        and ss.str().find("generating 579") != string::npos,
+                true);
+        if (not ok)
+            cerr << ss.str();
+    }
+
+    {
+        // statistics only with --verbose
+        stringstream ss;
+        auto buf = cerr.rdbuf(ss.rdbuf());
+        {
+            TestPrep prep(usage);
+            prep.buffer_extra(DATA_BIT, 123);
+        }
+        cerr.rdbuf(buf);
+        ok &= check("quiet without verbose",
+                ss.str().find("refill rounds") == string::npos, true);
+    }
+
+    if (ok)
+        cout << "adaptive batches ok" << endl;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,147 @@
+/*
+ * ot-kernel-benchmark.cpp
+ *
+ * Compare the generic and AVX-512 variants of the kernels used by
+ * OT extension: transposition, correlation, MMO hashing, and the
+ * carry-less inner products in the VOLE consistency check and for
+ * dot products in GF(2^n).
+ */
+
+#include "OT/BitMatrix.h"
+#include "Math/gf2nlong.h"
+#include "Tools/BitVector.h"
+#include "Tools/cpu_support.h"
+#include "Tools/time-func.h"
+#include "Tools/random.h"
+#include "Tools/MMO.hpp"
+
+#include <functional>
+#include <iostream>
+#include <iomanip>
+using namespace std;
+
+void report(string name, int n_iterations, function<void()> f)
+{
+    Timer timer;
+    timer.start();
+    for (int i = 0; i < n_iterations; i++)
+        f();
+    double elapsed = timer.elapsed();
+    cout << setw(30) << left << name << setw(10) << right
+            << 1e9 * elapsed / n_iterations << " ns per call" << endl;
+}
+
+int main(int argc, const char** argv)
+{
+    int n_iterations = 100000;
+    if (argc > 1)
+        n_iterations = atoi(argv[1]);
+
+    cout << "AVX-512: " << cpu_has_avx512() << ", VPCLMULQDQ: "
+            << cpu_has_vpclmul() << ", VAES: " << cpu_has_vaes() << endl;
+
+    PRNG G;
+    G.ReSeed();
+
+    square128 square, copy, other;
+    square.randomize(G);
+    other.randomize(G);
+
+    copy = square;
+    copy.transpose_generic();
+    report("transpose (generic)", n_iterations,
+            [&]() { square.transpose_generic(); });
+    if (cpu_has_avx512())
+    {
+        square128 check = copy;
+        check.transpose_generic();
+        check.transpose_avx512();
+        if (not (check == copy))
+            throw runtime_error("transposition mismatch");
+        report("transpose (AVX-512)", n_iterations,
+                [&]() { square.transpose_avx512(); });
+    }
+
+    BitVector conditions(128);
+    conditions.randomize(G);
+    copy = square;
+    copy.conditional_add_generic(conditions, other, 0);
+    report("conditional add (generic)", n_iterations,
+            [&]() { square.conditional_add_generic(conditions, other, 0); });
+    if (cpu_has_avx512())
+    {
+        square128 check = copy;
+        check.conditional_add_generic(conditions, other, 0);
+        check.conditional_add_avx512(conditions, other, 0);
+        if (not (check == copy))
+            throw runtime_error("conditional addition mismatch");
+        report("conditional add (AVX-512)", n_iterations,
+                [&]() { square.conditional_add_avx512(conditions, other, 0); });
+    }
+
+    const int n_blocks = 128;
+    __m128i blocks[n_blocks], coefficients[n_blocks], res[2];
+    G.get_octets((octet*) blocks, sizeof(blocks));
+    G.get_octets((octet*) coefficients, sizeof(coefficients));
+    __m128i expected[2] = {};
+    add_mul128_generic(expected, blocks, coefficients, n_blocks);
+    report("inner product (generic)", n_iterations,
+            [&]() { add_mul128_generic(res, blocks, coefficients, n_blocks); });
+    if (cpu_has_vpclmul())
+    {
+        __m128i check[2] = {};
+        add_mul128_vpclmul(check, blocks, coefficients, n_blocks);
+        if (not (int128(check[0]) == expected[0]
+                and int128(check[1]) == expected[1]))
+            throw runtime_error("inner product mismatch");
+        report("inner product (VPCLMULQDQ)", n_iterations,
+                [&]() { add_mul128_vpclmul(res, blocks, coefficients, n_blocks); });
+    }
+
+    word words[2][n_blocks];
+    G.get_octets((octet*) words, sizeof(words));
+    __m128i expected64 = _mm_setzero_si128(), res64;
+    add_mul64_generic(expected64, words[0], words[1], n_blocks);
+    report("64-bit product (generic)", n_iterations, [&]()
+    {
+        res64 = _mm_setzero_si128();
+        add_mul64_generic(res64, words[0], words[1], n_blocks);
+    });
+    if (cpu_has_vpclmul())
+    {
+        __m128i check = _mm_setzero_si128();
+        add_mul64_vpclmul(check, words[0], words[1], n_blocks);
+        if (not (int128(check) == expected64))
+            throw runtime_error("64-bit inner product mismatch");
+        report("64-bit product (VPCLMULQDQ)", n_iterations, [&]()
+        {
+            res64 = _mm_setzero_si128();
+            add_mul64_vpclmul(res64, words[0], words[1], n_blocks);
+        });
+    }
+
+    MMO mmo;
+    __m128i hashes[n_blocks], check[n_blocks];
+    for (int i = 0; i < n_blocks; i += 8)
+        mmo.hashEightBlocks(check + i, blocks + i);
+    report("MMO, 128 blocks (AES-NI)", n_iterations, [&]()
+    {
+        for (int i = 0; i < n_blocks; i += 8)
+            mmo.hashEightBlocks(hashes + i, blocks + i);
+    });
+    if (cpu_has_vaes())
+    {
+        mmo.hashManyBlocks(hashes, blocks, n_blocks);
+        for (int i = 0; i < n_blocks; i++)
+            if (not (int128(hashes[i]) == check[i]))
+                throw runtime_error("MMO mismatch");
+        // in place as in OT extension
+        memcpy(hashes, blocks, sizeof(hashes));
+        mmo.hashManyBlocks(hashes, hashes, n_blocks);
+        for (int i = 0; i < n_blocks; i++)
+            if (not (int128(hashes[i]) == check[i]))
+                throw runtime_error("MMO mismatch in place");
+        report("MMO, 128 blocks (VAES)", n_iterations,
+                [&]() { mmo.hashManyBlocks(hashes, blocks, n_blocks); });
+    }
+}
@@ -0,0 +1,139 @@
+/*
+ * share-batch-test.cpp
+ *
+ * Check the batched multiplication of share vectors by clear values
+ * (MULM) against the per-element operator* on random inputs and edge
+ * values, with lengths around the minimum size and the chunk size.
+ */
+
+#include "Protocols/Share.h"
+#include "Protocols/SemiShare.h"
+#include "Protocols/Semi2kShare.h"
+#include "Protocols/Spdz2kShare.h"
+#include "Processor/ShareBatch.hpp"
+#include "Math/gfp.hpp"
+#include "Math/Z2k.hpp"
+#include "Tools/random.h"
+
+#include <iostream>
+using namespace std;
+
+typedef gfp_<0, 2> gfp2;
+
+template<class T>
+bool equal(const T& x, const T& y)
+{
+    typedef BatchLayout<T> Layout;
+    for (int c = 0; c < Layout::N_COMPONENTS; c++)
+        if (Layout::get(x, c) != Layout::get(y, c))
+            return false;
+    return true;
+}
+
+template<class T>
+T share(const vector<typename BatchLayout<T>::domain_type>& edge, PRNG& G)
+{
+    typedef BatchLayout<T> Layout;
+    T res;
+    for (int c = 0; c < Layout::N_COMPONENTS; c++)
+    {
+        typename Layout::domain_type x;
+        if (G.get_uchar() % 2)
+            x = edge[G.get_uint(edge.size())];
+        else
+            x.randomize(G);
+        Layout::set(res, c, x);
+    }
+    return res;
+}
+
+template<class T>
+bool test(const vector<typename BatchLayout<T>::domain_type>& edge,
+        const vector<typename T::clear>& clear_edge, PRNG& G)
+{
+    typedef typename T::clear clear;
+    static_assert(ShareBatch<T>::supported, "batching not supported");
+    assert(ShareBatch<T>::Domain::has_mul());
+
+    BatchedOperations<T> operations;
+    bool ok = true;
+    size_t min_size = operations.MIN_SIZE, chunk_size = operations.CHUNK_SIZE;
+    for (size_t n : {min_size - 1, min_size, min_size + 1, chunk_size,
+            chunk_size + 1, 2 * chunk_size + min_size + 1})
+    {
+        vector<T> x(n), res(n);
+        vector<clear> y(n);
+        for (size_t i = 0; i < n; i++)
+        {
+            x[i] = share<T>(edge, G);
+            if (i < clear_edge.size())
+                y[i] = clear_edge[i];
+            else
+                y[i].randomize(G);
+        }
+
+        // every pair of edge values at least once
+        for (size_t i = 0; i < min(n, edge.size() * clear_edge.size()); i++)
+        {
+            for (int c = 0; c < BatchLayout<T>::N_COMPONENTS; c++)
+                BatchLayout<T>::set(x[i], c, edge[i / clear_edge.size()]);
+            y[i] = clear_edge[i % clear_edge.size()];
+        }
+
+        operations.mul(res.data(), x.data(), y.data(), n);
+        for (size_t i = 0; i < n; i++)
+        {
+            T expected = x[i] * y[i];
+            if (not equal(res[i], expected))
+            {
+                cerr << T::type_string() << " mismatch at " << i << " of "
+                        << n << ": " << x[i] << " * " << y[i] << ", expected "
+                        << expected << ", got " << res[i] << endl;
+                ok = false;
+                break;
+            }
+        }
+    }
+
+    cout << T::type_string() << ": " << (ok ? "ok" : "failed") << endl;
+    return ok;
+}
+
+template<int K>
+vector<Z2<K>> z2_edge()
+{
+    vector<Z2<K>> res = {0, 1, 2, Z2<K>(-1), Z2<K>(-2)};
+    for (int i : {K - 1, 63, 64})
+        if (i < K)
+        {
+            res.push_back(Z2<K>(1) << i);
+            res.push_back((Z2<K>(1) << i) - 1);
+        }
+    return res;
+}
+
+int main()
+{
+    PRNG G;
+    G.ReSeed();
+    bool ok = true;
+
+    gfp2::init_default(128);
+    bigint p = gfp2::pr();
+    vector<gfp2> gfp_edge;
+    for (bigint x : vector<bigint>({0, 1, 2, p - 1, p - 2,
+            (bigint(1) << 127) % p, (bigint(1) << 64) - 1}))
+        gfp_edge.push_back(x);
+    ok &= test<Share<gfp2>>(gfp_edge, gfp_edge, G);
+    ok &= test<SemiShare<gfp2>>(gfp_edge, gfp_edge, G);
+
+    auto z2_edge_128 = z2_edge<128>();
+    vector<SignedZ2<128>> signed_edge(z2_edge_128.begin(), z2_edge_128.end());
+    ok &= test<Semi2kShare<128>>(signed_edge, signed_edge, G);
+
+    auto z2_edge_64 = z2_edge<64>();
+    vector<SignedZ2<64>> clear_edge(z2_edge_64.begin(), z2_edge_64.end());
+    ok &= test<Spdz2kShare<64, 64>>(z2_edge_128, clear_edge, G);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,94 @@
+/*
+ * solinas-test.cpp
+ *
+ * Check multiplication modulo pseudo-Mersenne primes in standard
+ * representation against GMP and Montgomery multiplication, on random
+ * inputs and values near the prime.
+ */
+
+#include "Math/modp.hpp"
+#include "Math/Zp_Data.h"
+#include "Tools/random.h"
+
+#include <iostream>
+using namespace std;
+
+typedef modp_<4> T;
+
+bool check(const bigint& x, const bigint& y, const Zp_Data& solinas,
+        const Zp_Data& montgomery)
+{
+    bigint expected = x * y % solinas.pr;
+    bigint res[2];
+    const Zp_Data* ZpDs[] = {&solinas, &montgomery};
+    for (int i = 0; i < 2; i++)
+    {
+        T a, b, c;
+        to_modp(a, x, *ZpDs[i]);
+        to_modp(b, y, *ZpDs[i]);
+        Mul(c, a, b, *ZpDs[i]);
+        to_bigint(res[i], c, *ZpDs[i]);
+    }
+    if (res[0] != expected or res[1] != expected)
+    {
+        cerr << "mismatch modulo " << solinas.pr << " for " << x << " * "
+                << y << ": expected " << expected << ", got " << res[0]
+                << " (Solinas) and " << res[1] << " (Montgomery)" << endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    int n_tests = 10000;
+    if (argc > 1)
+        n_tests = atoi(argv[1]);
+
+    // 2^61 - 1, 2^64 - 59, 2^127 - 1, 2^130 - 5, 2^255 - 19
+    vector<pair<int, int>> primes = {{61, 1}, {64, 59}, {127, 1}, {130, 5},
+            {255, 19}};
+
+    PRNG G;
+    G.ReSeed();
+    bool ok = true;
+
+    for (auto& prime : primes)
+    {
+        bigint p = (bigint(1) << prime.first) - prime.second;
+        Zp_Data solinas(p, false), montgomery(p, true);
+        bool prime_ok = true;
+        if (not solinas.is_solinas())
+        {
+            cerr << p << " not recognized as pseudo-Mersenne prime" << endl;
+            ok = false;
+            continue;
+        }
+
+        vector<bigint> edge = {0, 1, 2, p - 1, p - 2, bigint(prime.second),
+                bigint(1) << (prime.first - 1), (bigint(1) << 64) - 1};
+        for (int i = 0; i < 10; i++)
+        {
+            bigint x;
+            G.randomBnd(x, bigint(1) << 32);
+            edge.push_back(p - 1 - x);
+        }
+        for (auto& x : edge)
+            for (auto& y : edge)
+                prime_ok &= check(x % p, y % p, solinas, montgomery);
+
+        for (int i = 0; i < n_tests; i++)
+        {
+            bigint x, y;
+            G.randomBnd(x, p);
+            G.randomBnd(y, p);
+            prime_ok &= check(x, y, solinas, montgomery);
+        }
+
+        cout << "2^" << prime.first << " - " << prime.second << ": "
+                << (prime_ok ? "ok" : "failed") << endl;
+        ok &= prime_ok;
+    }
+
+    return ok ? 0 : 1;
+}
@@ -14,6 +14,7 @@
 #include "Tools/Exceptions.h"
 #include "GC/RuntimeBranching.h"
 #include "GC/ThreadMaster.h"
+#include "Networking/CryptoPlayer.h"
 #include "YaoAndJob.h"
 
 #include <thread>
@@ -25,16 +26,26 @@ class YaoCommon : public GC::RuntimeBranching
 
     GC::ThreadMaster<GC::Secret<T>>& master;
 
+    // zero for sharing the cores among program threads
+    int n_worker_threads;
+
 public:
     static const int DONE = -1;
     static const int MORE = -2;
+    static const int CHUNK = -3;
 
     long counter;
 
     vector<YaoAndJob<T>*> jobs;
 
-    YaoCommon(GC::ThreadMaster<GC::Secret<T>>& master) :
-        log_n_threads(8), master(master), counter(0)
+    // garbled gates are sent in the background,
+    // so they use separate connections
+    Player* gate_player;
+
+    YaoCommon(GC::ThreadMaster<GC::Secret<T>>& master,
+            int n_worker_threads = 0) :
+        log_n_threads(8), master(master), n_worker_threads(n_worker_threads),
+        counter(0), gate_player(0)
     {
     }
 
@@ -42,6 +53,8 @@ public:
     {
         for (auto& job : jobs)
             delete job;
+        if (gate_player)
+            delete gate_player;
     }
 
     void init(typename T::Party& party)
@@ -49,6 +62,21 @@ public:
         jobs.resize(get_n_worker_threads());
         for (auto& job : jobs)
             job = new YaoAndJob<T>(party);
+
+        string id = "gates" + to_string(party.thread_num);
+        if (master.machine.use_encryption)
+            gate_player = new CryptoPlayer(master.N, id);
+        else
+            gate_player = new PlainPlayer(master.N, id);
+    }
+
+    // count gate communication with the thread
+    void add_gate_comm(Player& P)
+    {
+        P.thread_stats.at(1 - P.my_num()) += gate_player->total_comm();
+        gate_player->reset_stats();
+        for (auto& stats : gate_player->thread_stats)
+            stats.reset();
     }
 
     void set_n_program_threads(int n_threads)
@@ -63,9 +91,19 @@ public:
 
     int get_n_worker_threads()
     {
+        if (n_worker_threads > 0)
+            return n_worker_threads;
         return max(1u, thread::hardware_concurrency() / master.machine.nthreads);
     }
 
+    size_t get_max_gates_per_thread(int threshold, int total)
+    {
+        return max(threshold / 2,
+                (total + get_n_worker_threads() - 1) / get_n_worker_threads());
+    }
+
+    vector<int> split_vectors(const vector<int>& args, int threshold,
+            int total, bool repeat);
     vector<array<size_t, 2>> get_splits(const vector<int>& args, int threshold,
             int total);
 
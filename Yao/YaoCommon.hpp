@@ -5,13 +5,40 @@
 
 #include "YaoCommon.h"
 
+/**
+ * Breaks up vectors in AND instructions that are too long for a single thread
+ * into consecutive parts at register boundaries.
+ * This keeps the order of gates.
+ */
+template<class T>
+vector<int> YaoCommon<T>::split_vectors(const vector<int>& args,
+		int threshold, int total, bool repeat)
+{
+	int dl = GC::Secret<T>::default_length;
+	int max_units = max(size_t(1),
+			get_max_gates_per_thread(threshold, total) / dl);
+	vector<int> res;
+	res.reserve(args.size());
+	for (auto it = args.begin(); it < args.end(); it += 4)
+	{
+		int n_units = DIV_CEIL(*it, dl);
+		for (int j = 0; j < n_units; j += max_units)
+		{
+			res.push_back(min(max_units * dl, *it - j * dl));
+			res.push_back(*(it + 1) + j);
+			res.push_back(*(it + 2) + j);
+			res.push_back(*(it + 3) + (repeat ? 0 : j));
+		}
+	}
+	return res;
+}
+
 template<class T>
 vector<array<size_t, 2> > YaoCommon<T>::get_splits(const vector<int>& args,
 		int threshold, int total)
 {
 	vector<array<size_t, 2>> res;
-	size_t max_gates_per_thread = max(threshold / 2,
-			(total + get_n_worker_threads() - 1) / get_n_worker_threads());
+	size_t max_gates_per_thread = get_max_gates_per_thread(threshold, total);
 	size_t i_gate = 0;
 	for (auto it = args.begin(); it < args.end(); it += 4)
 	{
@@ -15,8 +15,10 @@
 #include "Processor/Instruction.hpp"
 #include "YaoWire.hpp"
 
-YaoEvalMaster::YaoEvalMaster(bool continuous, OnlineOptions& opts) :
-        ThreadMaster<GC::Secret<YaoEvalWire>>(opts), continuous(continuous)
+YaoEvalMaster::YaoEvalMaster(bool continuous, OnlineOptions& opts,
+        size_t garbled_memory, int n_worker_threads) :
+        ThreadMaster<GC::Secret<YaoEvalWire>>(opts), continuous(continuous),
+        garbled_memory(garbled_memory), n_worker_threads(n_worker_threads)
 {
 }
 
@@ -15,7 +15,14 @@ class YaoEvalMaster : public GC::ThreadMaster<GC::Secret<YaoEvalWire>>
 public:
     bool continuous;
 
-    YaoEvalMaster(bool continuous, OnlineOptions& opts);
+    // bytes of garbled circuit kept in memory with one-shot computation
+    size_t garbled_memory;
+
+    // per program thread, zero for sharing the cores
+    int n_worker_threads;
+
+    YaoEvalMaster(bool continuous, OnlineOptions& opts,
+            size_t garbled_memory = size_t(1) << 30, int n_worker_threads = 0);
 
     GC::Thread<GC::Secret<YaoEvalWire>>* new_thread(int i);
 };
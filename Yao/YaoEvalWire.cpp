@@ -8,6 +8,7 @@
 #include "YaoGate.h"
 #include "YaoEvaluator.h"
 #include "YaoEvalInput.h"
+#include "YaoGateBatch.h"
 #include "BMR/prf.h"
 #include "BMR/common.h"
 #include "GC/ArgTuples.h"
@@ -45,15 +46,16 @@ void YaoEvalWire::and_(GC::Processor<GC::Secret<YaoEvalWire> >& processor,
 	}
 
 	processor.complexity += total;
+	auto split_args = party.split_vectors(args, threshold, total, repeat);
 	int i_thread = 0, start = 0;
-	for (auto& x : party.get_splits(args, threshold, total))
+	for (auto& x : party.get_splits(split_args, threshold, total))
 	{
 		auto i_gate = x[0];
 		auto end = x[1];
-		YaoGate* gate = (YaoGate*) party.gates.consume(
+		YaoGate* gate = (YaoGate*) party.consume_gates(
 				i_gate * sizeof(YaoGate));
-		party.jobs[i_thread++]->dispatch(YAO_AND_JOB, processor, args, start,
-				end, i_gate, gate, party.get_gate_id(), repeat);
+		party.jobs[i_thread++]->dispatch(YAO_AND_JOB, processor, split_args,
+				start, end, i_gate, gate, party.get_gate_id(), repeat);
 		party.counter += i_gate;
 		start = end;
 	}
@@ -69,7 +71,8 @@ void YaoEvalWire::and_singlethread(GC::Processor<GC::Secret<YaoEvalWire> >& proc
 	processor.complexity += total_ands;
 	size_t n_args = args.size();
 	YaoEvaluator& party = YaoEvaluator::s();
-	YaoGate* gate = (YaoGate*) party.gates.consume(total_ands * sizeof(YaoGate));
+	YaoGate* gate = (YaoGate*) party.consume_gates(
+			total_ands * sizeof(YaoGate));
 	long counter = party.get_gate_id();
 	map<string, Timer> timers;
 	SeededPRNG prng;
@@ -84,25 +87,16 @@ void YaoEvalWire::and_(GC::Memory<GC::Secret<YaoEvalWire> >& S,
 		bool repeat, YaoEvaluator& evaluator)
 {
 	int dl = GC::Secret<YaoEvalWire>::default_length;
-	MMO& mmo = evaluator.mmo;
+	YaoGateBatch<YaoEvalWire> batch;
 	for (auto it = args.begin() + start; it < args.begin() + end; it += 4)
 	{
 		if (*it == 1)
 		{
-			Key label[YaoGate::N_EVAL_HASHES];
-			Key hash[YaoGate::N_EVAL_HASHES];
-			gate_id++;
-			YaoGate::eval_inputs(label,
-					S[*(it + 2)].get_reg(0).key(),
-					S[*(it + 3)].get_reg(0).key(),
-					gate_id);
-			mmo.hash<YaoGate::N_EVAL_HASHES>(hash, label);
 			auto& out = S[*(it + 1)];
 			out.resize_regs(1);
-			YaoGate& gate = *gates;
-			gates++;
-			gate.eval(out.get_reg(0), hash, S[*(it + 2)].get_reg(0),
-					S[*(it + 3)].get_reg(0));
+			if (batch.add(out.get_reg(0), S[*(it + 2)].get_reg(0),
+					S[*(it + 3)].get_reg(0)))
+				and_(batch, gates, gate_id, evaluator);
 		}
 		else
 		{
@@ -115,23 +109,29 @@ void YaoEvalWire::and_(GC::Memory<GC::Secret<YaoEvalWire> >& S,
 				int n = min(dl, *it - j * dl);
 				out.resize_regs(n);
 				for (int k = 0; k < n; k++)
-				{
-					Key label[YaoGate::N_EVAL_HASHES];
-					Key hash[YaoGate::N_EVAL_HASHES];
-					auto& left_wire = left.get_reg(k);
-					auto& right_key = right.get_reg(repeat ? 0 : k).key();
-					gate_id++;
-					YaoGate::eval_inputs(label, left_wire.key(), right_key,
-							gate_id);
-					mmo.hash<YaoGate::N_EVAL_HASHES>(hash, label);
-					auto& right_wire = right.get_reg(repeat ? 0 : k);
-					YaoGate& gate = *gates;
-					gates++;
-					gate.eval(out.get_reg(k), hash, left_wire, right_wire);
-				}
+					if (batch.add(out.get_reg(k), left.get_reg(k),
+							right.get_reg(repeat ? 0 : k)))
+						and_(batch, gates, gate_id, evaluator);
 			}
 		}
 	}
+	and_(batch, gates, gate_id, evaluator);
+}
+
+void YaoEvalWire::and_(YaoGateBatch<YaoEvalWire>& batch, YaoGate*& gates,
+		long& gate_id, YaoEvaluator& evaluator)
+{
+	const int n_hashes = YaoGate::N_EVAL_HASHES;
+	Key labels[n_hashes * YaoGateBatch<YaoEvalWire>::N_GATES];
+	Key hashes[n_hashes * YaoGateBatch<YaoEvalWire>::N_GATES];
+	for (int i = 0; i < batch.size; i++)
+		YaoGate::eval_inputs(labels + n_hashes * i, batch.lefts[i]->key(),
+				batch.rights[i]->key(), ++gate_id);
+	evaluator.mmo.hash(hashes, labels, n_hashes * batch.size);
+	for (int i = 0; i < batch.size; i++)
+		(gates++)->eval(*batch.outputs[i], hashes + n_hashes * i,
+				*batch.lefts[i], *batch.rights[i]);
+	batch.size = 0;
 }
 
 template<class T>
@@ -194,7 +194,7 @@ void YaoEvalWire::op(const YaoEvalWire& left, const YaoEvalWire& right,
 bool YaoEvalWire::get_output()
 {
 	YaoEvaluator::s().taint();
-	bool res = external() ^ YaoEvaluator::s().output_masks.pop_front();
+	bool res = external() ^ YaoEvaluator::s().pop_output_mask();
 #ifdef DEBUG
     cout << "output " << res << " mask " << (external() ^ res) << " external() "
             << external() << endl;
@@ -16,6 +16,7 @@
 
 class YaoEvaluator;
 class YaoEvalInput;
+template<class T> class YaoGateBatch;
 class ProcessorBase;
 
 class YaoEvalWire : public YaoWire
@@ -52,6 +53,8 @@ public:
 			const vector<int>& args, size_t start, size_t end,
 			size_t total_ands, YaoGate* gate, long& counter, PRNG& prng,
 			map<string, Timer>& timers, bool repeat, YaoEvaluator& garbler);
+	static void and_(YaoGateBatch<YaoEvalWire>& batch, YaoGate*& gates,
+			long& gate_id, YaoEvaluator& evaluator);
 
 	static void inputb(GC::Processor<GC::Secret<YaoEvalWire>>& processor,
 			const vector<int>& args);
@@ -18,7 +18,9 @@ thread_local YaoEvaluator* YaoEvaluator::singleton = 0;
 
 YaoEvaluator::YaoEvaluator(int thread_num, YaoEvalMaster& master) :
 		Thread<GC::Secret<YaoEvalWire>>(thread_num, master),
-		YaoCommon<YaoEvalWire>(master),
+		YaoCommon<YaoEvalWire>(master, master.n_worker_threads),
+		chunked(false),
+		circuit(thread_num, master.garbled_memory),
 		master(master),
 		player(N, 0, "thread" + to_string(thread_num)),
 		ot_ext(OTExtensionWithMatrix::setup(player, {}, RECEIVER, true))
@@ -32,7 +34,12 @@ void YaoEvaluator::pre_run()
 	if (master.opts.cmd_private_output_file.empty())
 		processor.out.activate(not continuous());
 	if (not continuous())
-		receive_to_store(*P);
+		receive_to_store(*gate_player);
+}
+
+void YaoEvaluator::post_run()
+{
+	add_gate_comm(*P);
 }
 
 void YaoEvaluator::run(GC::Program& program)
@@ -40,7 +47,7 @@ void YaoEvaluator::run(GC::Program& program)
 	singleton = this;
 
 	if (continuous())
-		run(program, *P);
+		run(program, *gate_player);
 	else
 	{
 		run_from_store(program);
@@ -60,6 +67,7 @@ void YaoEvaluator::run(GC::Program& program, Player& P)
 		catch (needs_cleaning& e)
 		{
 		}
+		finish_round();
 	}
 	while(GC::DONE_BREAK != next);
 }
@@ -67,12 +75,14 @@ void YaoEvaluator::run(GC::Program& program, Player& P)
 void YaoEvaluator::run_from_store(GC::Program& program)
 {
 	machine.reset_timer();
+	GC::BreakType next;
 	do
 	{
-		gates_store.pop(gates);
-		output_masks_store.pop(output_masks);
+		pop_from_store();
+		next = program.execute(processor, master.memory, -1);
+		finish_round();
 	}
-	while(GC::DONE_BREAK != program.execute(processor, master.memory, -1));
+	while(GC::DONE_BREAK != next);
 }
 
 bool YaoEvaluator::receive(Player& P)
@@ -80,10 +90,12 @@ bool YaoEvaluator::receive(Player& P)
 #ifdef DEBUG_YAO
 	printf("waiting to receive at %d in thread %d\n", processor.PC, thread_num);
 #endif
-	if (P.receive_long(0) == YaoCommon::DONE)
+	long status = P.receive_long(0);
+	if (status == YaoCommon::DONE)
 		return false;
 	P.receive_player(0, gates);
 	P.receive_player(0, output_masks);
+	chunked = status == YaoCommon::CHUNK;
 #ifdef DEBUG_YAO
 	cout << "received " << gates.size() << " bytes for gates and "
 			<< output_masks.size() << " output masks at " << processor.PC
@@ -94,9 +106,37 @@ bool YaoEvaluator::receive(Player& P)
 
 void YaoEvaluator::receive_to_store(Player& P)
 {
+#ifdef VERBOSE
+	Timer timer;
+	timer.start();
+#endif
 	while (receive(P))
-	{
-		gates_store.push(gates);
-		output_masks_store.push(output_masks);
-	}
+		circuit.push(gates, output_masks, chunked);
+	circuit.map();
+#ifdef VERBOSE
+	cerr << "Received " << circuit.size() * 1e-6
+			<< " MB of garbled circuit in " << timer.elapsed() << " seconds"
+			<< endl;
+#endif
+}
+
+void YaoEvaluator::pop_from_store()
+{
+	circuit.pop(gates, output_masks, chunked);
+}
+
+void YaoEvaluator::receive_chunk()
+{
+	if (not chunked)
+		throw runtime_error("no more garbled gates in this round");
+	if (continuous())
+		receive(*gate_player);
+	else
+		pop_from_store();
+}
+
+void YaoEvaluator::finish_round()
+{
+	while (chunked)
+		receive_chunk();
 }
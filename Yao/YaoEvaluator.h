@@ -9,6 +9,7 @@
 #include "YaoGate.h"
 #include "YaoEvalMaster.h"
 #include "YaoCommon.h"
+#include "YaoGarbledCircuit.h"
 #include "GC/Secret.h"
 #include "GC/Thread.h"
 #include "Tools/MMO.h"
@@ -23,7 +24,12 @@ protected:
 	static thread_local YaoEvaluator* singleton;
 
 	ReceivedMsg gates;
-	ReceivedMsgStore gates_store;
+
+	// more gates to come in the current round
+	bool chunked;
+
+	// everything received before evaluation with one-shot computation
+	YaoGarbledCircuit circuit;
 
 	YaoEvalMaster& master;
 
@@ -32,7 +38,6 @@ protected:
 
 public:
 	ReceivedMsg output_masks;
-	ReceivedMsgStore output_masks_store;
 
 	MMO mmo;
 
@@ -46,25 +51,44 @@ public:
 	bool continuous() { return master.continuous; }
 
 	void pre_run();
+	void post_run();
 	void run(GC::Program& program);
 	void run(GC::Program& program, Player& P);
 	void run_from_store(GC::Program& program);
 	bool receive(Player& P);
 	void receive_to_store(Player& P);
+	void pop_from_store();
+	void receive_chunk();
+	void finish_round();
 
+	char* consume_gates(size_t size);
 	void load_gate(YaoGate& gate);
+	bool pop_output_mask();
 
 	long get_gate_id() { return gate_id(thread_num); }
-
-	int get_n_worker_threads()
-	{ return max(1u, thread::hardware_concurrency() / master.machine.nthreads); }
 };
 
+inline char* YaoEvaluator::consume_gates(size_t size)
+{
+	while (size and gates.left() == 0)
+		receive_chunk();
+	return gates.consume(size);
+}
+
 inline void YaoEvaluator::load_gate(YaoGate& gate)
 {
+	while (gates.left() == 0)
+		receive_chunk();
 	gates.unserialize(gate);
 }
 
+inline bool YaoEvaluator::pop_output_mask()
+{
+	while (output_masks.left() == 0)
+		receive_chunk();
+	return output_masks.pop_front();
+}
+
 inline YaoEvaluator& YaoEvaluator::s()
 {
 	if (singleton)
@@ -15,8 +15,10 @@
 #include "Processor/Instruction.hpp"
 #include "YaoWire.hpp"
 
-YaoGarbleMaster::YaoGarbleMaster(bool continuous, OnlineOptions& opts, int threshold) :
-        super(opts), continuous(continuous), threshold(threshold)
+YaoGarbleMaster::YaoGarbleMaster(bool continuous, OnlineOptions& opts,
+        int threshold, int n_worker_threads) :
+        super(opts), continuous(continuous), threshold(threshold),
+        n_worker_threads(n_worker_threads)
 {
     PRNG G;
     G.ReSeed();
@@ -20,8 +20,11 @@ class YaoGarbleMaster : public GC::ThreadMaster<GC::Secret<YaoGarbleWire>>
 public:
     bool continuous;
     int threshold;
+    // per program thread, zero for sharing the cores
+    int n_worker_threads;
 
-    YaoGarbleMaster(bool continuous, OnlineOptions& opts, int threshold = 1024);
+    YaoGarbleMaster(bool continuous, OnlineOptions& opts, int threshold = 1024,
+            int n_worker_threads = 0);
 
     GC::Thread<GC::Secret<YaoGarbleWire>>* new_thread(int i);
 
@@ -7,6 +7,7 @@
 #include "YaoGate.h"
 #include "YaoGarbler.h"
 #include "YaoGarbleInput.h"
+#include "YaoGateBatch.h"
 #include "GC/ArgTuples.h"
 #include "Tools/pprint.h"
 
@@ -33,12 +34,13 @@ void YaoGarbleWire::public_input(bool value)
 void YaoGarbleWire::and_(GC::Processor<GC::Secret<YaoGarbleWire> >& processor,
 		const vector<int>& args, bool repeat)
 {
-#ifdef YAO_TIMINGS
 	auto& garbler = YaoGarbler::s();
+#ifdef YAO_TIMINGS
 	TimeScope ts(garbler.and_timer), ts2(garbler.and_proc_timer),
 			ts3(garbler.and_main_thread_timer);
 #endif
 	and_multithread(processor, args, repeat);
+	garbler.stream_gates();
 }
 
 void YaoGarbleWire::and_multithread(GC::Processor<GC::Secret<YaoGarbleWire> >& processor,
@@ -57,16 +59,18 @@ void YaoGarbleWire::and_multithread(GC::Processor<GC::Secret<YaoGarbleWire> >& p
 	processor.complexity += total;
 	SendBuffer& gates = party.gates;
 	gates.allocate(total * sizeof(YaoGate));
+	auto split_args = party.split_vectors(args, party.get_threshold(),
+			total, repeat);
 	int i_thread = 0, start = 0;
-	for (auto& x : party.get_splits(args, party.get_threshold(), total))
+	for (auto& x : party.get_splits(split_args, party.get_threshold(), total))
 	{
 		int i_gate = x[0];
 		int end = x[1];
 		YaoGate* gate = (YaoGate*)gates.end();
 		gates.skip(i_gate * sizeof(YaoGate));
 		party.timers["Dispatch"].start();
-		party.jobs[i_thread++]->dispatch(YAO_AND_JOB, processor, args, start,
-				end, i_gate, gate, party.get_gate_id(), repeat);
+		party.jobs[i_thread++]->dispatch(YAO_AND_JOB, processor, split_args,
+				start, end, i_gate, gate, party.get_gate_id(), repeat);
 		party.timers["Dispatch"].stop();
 		party.counter += i_gate;
 		i_gate = 0;
@@ -101,28 +105,17 @@ void YaoGarbleWire::and_(GC::Memory<GC::Secret<YaoGarbleWire> >& S,
 		bool repeat, YaoGarbler& garbler)
 {
 	(void)timers;
-	const Key& delta = garbler.get_delta();
 	int dl = GC::Secret<YaoGarbleWire>::default_length;
-	Key left_delta = delta.doubling(1);
-	Key right_delta = delta.doubling(2);
-	Key labels[4];
-	Key hashes[4];
-	MMO& mmo = garbler.mmo;
+	YaoGateBatch<YaoGarbleWire> batch;
 	for (auto it = args.begin() + start; it < args.begin() + end; it += 4)
 	{
 		if (*it == 1)
 		{
-			counter++;
-			YaoGate::E_inputs(labels, S[*(it + 2)].get_reg(0),
-					S[*(it + 3)].get_reg(0), left_delta, right_delta,
-					counter);
-			mmo.hash<4>(hashes, labels);
 			auto& out = S[*(it + 1)];
 			out.resize_regs(1);
-			YaoGate::randomize(out.get_reg(0), prng);
-			(gate++)->and_garble(out.get_reg(0), hashes,
-					S[*(it + 2)].get_reg(0),
-					S[*(it + 3)].get_reg(0), garbler.get_delta());
+			if (batch.add(out.get_reg(0), S[*(it + 2)].get_reg(0),
+					S[*(it + 3)].get_reg(0)))
+				and_(batch, gate, counter, prng, garbler);
 		}
 		else
 		{
@@ -137,26 +130,37 @@ void YaoGarbleWire::and_(GC::Memory<GC::Secret<YaoGarbleWire> >& S,
 					auto& left_wire = S[*(it + 2) + j].get_reg(k);
 					auto& right_wire = S[*(it + 3) + (repeat ? 0 : j)].get_reg(
 							repeat ? 0 : k);
-					counter++;
-					YaoGate::E_inputs(labels, left_wire,
-							right_wire, left_delta, right_delta, counter);
-					mmo.hash<4>(hashes, labels);
-					//timers["Inner ref"].start();
-					//timers["Inner ref"].stop();
-					//timers["Randomizing"].start();
-					out.get_reg(k).randomize(prng);
-					//timers["Randomizing"].stop();
-					//timers["Gate computation"].start();
-					(gate++)->and_garble(out.get_reg(k), hashes,
-							left_wire, right_wire,
-							garbler.get_delta());
-					//timers["Gate computation"].stop();
+					if (batch.add(out.get_reg(k), left_wire, right_wire))
+						and_(batch, gate, counter, prng, garbler);
 				}
 			}
 		}
 	}
+	and_(batch, gate, counter, prng, garbler);
 }
 
+void YaoGarbleWire::and_(YaoGateBatch<YaoGarbleWire>& batch, YaoGate*& gate,
+		long& counter, PRNG& prng, YaoGarbler& garbler)
+{
+	const Key& delta = garbler.get_delta();
+	Key left_delta = delta.doubling(1);
+	Key right_delta = delta.doubling(2);
+	const int n_hashes = YaoGate::N_GARBLE_HASHES;
+	Key labels[n_hashes * YaoGateBatch<YaoGarbleWire>::N_GATES];
+	Key hashes[n_hashes * YaoGateBatch<YaoGarbleWire>::N_GATES];
+	for (int i = 0; i < batch.size; i++)
+		YaoGate::E_inputs(labels + n_hashes * i, *batch.lefts[i],
+				*batch.rights[i], left_delta, right_delta, ++counter);
+	garbler.mmo.hash(hashes, labels, n_hashes * batch.size);
+	for (int i = 0; i < batch.size; i++)
+	{
+		auto& out = *batch.outputs[i];
+		YaoGate::randomize(out, prng);
+		(gate++)->and_garble(out, hashes + n_hashes * i, *batch.lefts[i],
+				*batch.rights[i], delta);
+	}
+	batch.size = 0;
+}
 
 void YaoGarbleWire::inputb(GC::Processor<GC::Secret<YaoGarbleWire>>& processor,
         const vector<int>& args)
@@ -164,6 +168,7 @@ void YaoGarbleWire::inputb(GC::Processor<GC::Secret<YaoGarbleWire>>& processor,
 	auto& garbler = YaoGarbler::s();
 	YaoGarbleInput input;
 	processor.inputb(input, processor, args, garbler.P->my_num());
+	garbler.answer_receiver_inputs();
 }
 
 void YaoGarbleWire::inputbvec(GC::Processor<GC::Secret<YaoGarbleWire>>& processor,
@@ -172,6 +177,7 @@ void YaoGarbleWire::inputbvec(GC::Processor<GC::Secret<YaoGarbleWire>>& processo
     auto& garbler = YaoGarbler::s();
     YaoGarbleInput input;
     processor.inputbvec(input, input_processor, args, *garbler.P);
+    garbler.answer_receiver_inputs();
 }
 
 inline void YaoGarbler::store_gate(const YaoGate& gate)
@@ -187,6 +193,7 @@ void YaoGarbleWire::op(const YaoGarbleWire& left, const YaoGarbleWire& right,
 	YaoGarbler::s().counter++;
 	YaoGate gate(*this, left, right, func);
 	YaoGarbler::s().store_gate(gate);
+	garbler.stream_gates();
 }
 
 char YaoGarbleWire::get_output()
@@ -205,6 +212,7 @@ void YaoGarbleWire::convcbit(Integer& dest, const GC::Clear& source,
 	else
 	{
 		garbler.untaint();
+		garbler.wait_for_sending();
 		dest = garbler.P->receive_long(1);
 	}
 }
@@ -217,6 +225,7 @@ void YaoGarbleWire::reveal_inst(Processor& processor, const vector<int>& args)
 		if (garbler.is_tainted())
 			processor.reveal(args);
 		garbler.untaint();
+		garbler.wait_for_sending();
 		octetStream buffer;
 		garbler.P->receive_player(1, buffer);
 		for (size_t j = 0; j < args.size(); j += 3)
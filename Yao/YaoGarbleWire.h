@@ -16,6 +16,7 @@
 
 class YaoGarbler;
 class YaoGarbleInput;
+template<class T> class YaoGateBatch;
 class ProcessorBase;
 
 class YaoGarbleWire : public YaoWire
@@ -53,6 +54,8 @@ public:
 			const vector<int>& args, size_t start, size_t end,
 			size_t total_ands, YaoGate* gate, long& counter, PRNG& prng,
 			map<string, Timer>& timers, bool repeat, YaoGarbler& garbler);
+	static void and_(YaoGateBatch<YaoGarbleWire>& batch, YaoGate*& gate,
+			long& counter, PRNG& prng, YaoGarbler& garbler);
 
 	static void inputb(GC::Processor<GC::Secret<YaoGarbleWire>>& processor,
 			const vector<int>& args);
@@ -0,0 +1,118 @@
+/*
+ * YaoGarbledCircuit.cpp
+ *
+ */
+
+#include "YaoGarbledCircuit.h"
+#include "Math/Setup.h"
+#include "Tools/Exceptions.h"
+#include "Tools/int.h"
+
+#include <sys/mman.h>
+
+YaoGarbledCircuit::YaoGarbledCircuit(int thread_num, size_t memory_limit) :
+		memory_size(0), memory_limit(memory_limit), pos(0), file_size(0)
+{
+	path = boost::filesystem::unique_path(
+			PREP_DIR "Yao-Garbled-T" + to_string(thread_num)
+					+ "-%%%%-%%%%-%%%%");
+}
+
+YaoGarbledCircuit::~YaoGarbledCircuit()
+{
+	if (out.is_open())
+		out.close();
+	if (file.is_open())
+		file.close();
+	if (file_size)
+		boost::filesystem::remove(path);
+}
+
+void YaoGarbledCircuit::push(ReceivedMsg& gates, ReceivedMsg& output_masks,
+		bool chunked)
+{
+	size_t size = gates.size() + output_masks.size();
+	if (file_size == 0 and memory_size + size <= memory_limit)
+	{
+		// moving the buffers avoids copying
+		rounds.emplace_back();
+		rounds.back().gates = gates;
+		rounds.back().output_masks = output_masks;
+		rounds.back().chunked = chunked;
+		memory_size += size;
+	}
+	else
+		spill(gates, output_masks, chunked);
+}
+
+void YaoGarbledCircuit::spill(ReceivedMsg& gates, ReceivedMsg& output_masks,
+		bool chunked)
+{
+	if (not out.is_open())
+	{
+		out.open(path.native(), ios::binary);
+		if (not out.good())
+			throw file_error(path.native());
+	}
+
+	size_t header[] = {gates.size(), output_masks.size(), chunked};
+	write((char*) header, sizeof(header));
+	write(gates.data(), gates.size());
+	write(output_masks.data(), output_masks.size());
+	if (not out.good())
+		throw runtime_error("cannot write garbled circuit to "
+				+ path.native() + ", check space on " PREP_DIR);
+}
+
+size_t YaoGarbledCircuit::padded(size_t len)
+{
+	return DIV_CEIL(len, ALIGNMENT) * ALIGNMENT;
+}
+
+void YaoGarbledCircuit::write(const char* data, size_t len)
+{
+	char zeros[ALIGNMENT] = {};
+	out.write(data, len);
+	out.write(zeros, padded(len) - len);
+	file_size += padded(len);
+}
+
+void YaoGarbledCircuit::map()
+{
+	if (file_size == 0)
+		return;
+	out.close();
+	file.open(path);
+	assert(file.size() == file_size);
+	madvise((void*) file.data(), file.size(), MADV_SEQUENTIAL);
+}
+
+void YaoGarbledCircuit::pop(ReceivedMsg& msg, size_t len)
+{
+	assert(size_t(file.data() + pos) % ALIGNMENT == 0);
+	msg.borrow(file.data() + pos, len);
+	pos += padded(len);
+}
+
+void YaoGarbledCircuit::pop(ReceivedMsg& gates, ReceivedMsg& output_masks,
+		bool& chunked)
+{
+	if (not rounds.empty())
+	{
+		auto& round = rounds.front();
+		gates = round.gates;
+		output_masks = round.output_masks;
+		chunked = round.chunked;
+		rounds.pop_front();
+		return;
+	}
+
+	size_t header[3];
+	if (pos + padded(sizeof(header)) > file_size)
+		throw runtime_error("garbled circuit exhausted");
+	memcpy(header, file.data() + pos, sizeof(header));
+	chunked = header[2];
+	pos += padded(sizeof(header));
+	pop(gates, header[0]);
+	pop(output_masks, header[1]);
+}
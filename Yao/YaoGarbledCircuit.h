@@ -0,0 +1,58 @@
+/*
+ * YaoGarbledCircuit.h
+ *
+ */
+
+#ifndef YAO_YAOGARBLEDCIRCUIT_H_
+#define YAO_YAOGARBLEDCIRCUIT_H_
+
+#include "Tools/FlexBuffer.h"
+
+#include <fstream>
+#include <deque>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/filesystem.hpp>
+
+/**
+ * Garbled circuit received before evaluation. Rounds are kept in memory
+ * up to a size limit, and the rest is appended to a single file, which
+ * is memory-mapped and evaluated without copying. Everything in the file
+ * starts at a multiple of 16 bytes because the gates contain keys as
+ * __m128i.
+ */
+class YaoGarbledCircuit
+{
+	static const size_t ALIGNMENT = 16;
+
+	struct Round
+	{
+		ReceivedMsg gates, output_masks;
+		bool chunked;
+	};
+
+	deque<Round> rounds;
+	size_t memory_size, memory_limit;
+
+	boost::filesystem::path path;
+	ofstream out;
+	boost::iostreams::mapped_file_source file;
+	size_t pos, file_size;
+
+	static size_t padded(size_t len);
+
+	void spill(ReceivedMsg& gates, ReceivedMsg& output_masks, bool chunked);
+	void write(const char* data, size_t len);
+	void pop(ReceivedMsg& msg, size_t len);
+
+public:
+	YaoGarbledCircuit(int thread_num, size_t memory_limit);
+	~YaoGarbledCircuit();
+
+	void push(ReceivedMsg& gates, ReceivedMsg& output_masks, bool chunked);
+	void map();
+	void pop(ReceivedMsg& gates, ReceivedMsg& output_masks, bool& chunked);
+
+	size_t size() { return memory_size + file_size; }
+};
+
+#endif /* YAO_YAOGARBLEDCIRCUIT_H_ */
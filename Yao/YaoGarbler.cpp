@@ -19,7 +19,7 @@ thread_local YaoGarbler* YaoGarbler::singleton = 0;
 
 YaoGarbler::YaoGarbler(int thread_num, YaoGarbleMaster& master) :
 		GC::Thread<GC::Secret<YaoGarbleWire>>(thread_num, master),
-		YaoCommon<YaoGarbleWire>(master),
+		YaoCommon<YaoGarbleWire>(master, master.n_worker_threads),
 		master(master),
 		and_proc_timer(CLOCK_PROCESS_CPUTIME_ID),
 		and_main_thread_timer(CLOCK_THREAD_CPUTIME_ID),
@@ -74,7 +74,7 @@ void YaoGarbler::run(GC::Program& program)
 				throw runtime_error("run-time branching impossible with garbling at once");
 			processor.PC--;
 		}
-		send(*P);
+		send(*gate_player);
 		gates.clear();
 		output_masks.clear();
 		if (continuous())
@@ -86,9 +86,12 @@ void YaoGarbler::post_run()
 {
 	if (not continuous())
 	{
-		P->send_long(1, YaoCommon::DONE);
+		gate_player->send_long(1, YaoCommon::DONE);
 		process_receiver_inputs();
 	}
+
+	sender.wait();
+	add_gate_comm(*P);
 }
 
 void YaoGarbler::send(Player& P)
@@ -98,11 +101,26 @@ void YaoGarbler::send(Player& P)
 			<< output_masks.size() << " output masks at " << processor.PC
 			<< " in thread " << thread_num << endl;
 #endif
-	P.send_long(1, YaoCommon::MORE);
 	size_t size = gates.size();
-	P.send_to(1, gates);
+	sender.send(P, YaoCommon::MORE, gates, output_masks);
+	sender.wait();
 	gates.allocate(2 * size);
-	P.send_to(1, output_masks);
+}
+
+/**
+ * With streaming, the evaluator reaches its input after the gates sent so
+ * far and then waits for the oblivious transfer, so send the remaining
+ * gates of this round and answer straight away instead of at the end of
+ * the round
+ */
+void YaoGarbler::answer_receiver_inputs()
+{
+	if (not continuous() or receiver_input_keys.empty())
+		return;
+	size_t size = gates.size();
+	sender.send(*gate_player, YaoCommon::CHUNK, gates, output_masks);
+	gates.allocate(size);
+	process_receiver_inputs();
 }
 
 void YaoGarbler::process_receiver_inputs()
@@ -8,6 +8,7 @@
 
 #include "YaoGarbleWire.h"
 #include "YaoAndJob.h"
+#include "YaoSendJob.h"
 #include "YaoGarbleMaster.h"
 #include "YaoCommon.h"
 #include "Tools/random.h"
@@ -32,6 +33,7 @@ protected:
 	YaoGarbleMaster& master;
 
 	SendBuffer gates;
+	YaoSendJob sender;
 
 	Timer and_timer;
 	Timer and_proc_timer;
@@ -40,6 +42,9 @@ protected:
 	DoubleTimer and_wait_timer;
 
 public:
+	// garbled gates are sent in the background once this is reached
+	static const size_t CHUNK_SIZE = 1 << 20;
+
 	PRNG prng;
 	SendBuffer output_masks;
 	MMO mmo;
@@ -62,8 +67,11 @@ public:
 	void run(Player& P, bool continuous);
 	void post_run();
 	void send(Player& P);
+	void stream_gates();
+	void wait_for_sending() { sender.wait(); }
 
 	void process_receiver_inputs();
+	void answer_receiver_inputs();
 
 	Key get_delta() { return master.get_delta(); }
 	void store_gate(const YaoGate& gate);
@@ -73,6 +81,16 @@ public:
 	long get_gate_id() { return gate_id(thread_num); }
 };
 
+inline void YaoGarbler::stream_gates()
+{
+	if (gates.size() >= CHUNK_SIZE)
+	{
+		size_t size = gates.size();
+		sender.send(*gate_player, YaoCommon::CHUNK, gates, output_masks);
+		gates.allocate(size);
+	}
+}
+
 inline YaoGarbler& YaoGarbler::s()
 {
 	if (singleton)
@@ -11,6 +11,7 @@
 #include "YaoGarbleWire.h"
 #include "YaoEvalWire.h"
 #include "YaoHalfGate.h"
+#include "YaoThreeHalvesGate.h"
 
 class YaoFullGate
 {
@@ -18,6 +19,7 @@ class YaoFullGate
 
 public:
 	static const int N_EVAL_HASHES = 1;
+	static const int N_GARBLE_HASHES = 4;
 
 	static Key E_input(const Key& left, const Key& right, long T);
 	static void E_inputs(Key* output, const YaoGarbleWire& left,
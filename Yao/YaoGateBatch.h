@@ -0,0 +1,40 @@
+/*
+ * YaoGateBatch.h
+ *
+ */
+
+#ifndef YAO_YAOGATEBATCH_H_
+#define YAO_YAOGATEBATCH_H_
+
+/**
+ * Wires of independent AND gates collected in order to hash
+ * the labels of several gates at once, which keeps more AES blocks
+ * in flight than hashing gate by gate
+ */
+template<class T>
+class YaoGateBatch
+{
+public:
+	static const int N_GATES = 16;
+
+	T* outputs[N_GATES];
+	const T* lefts[N_GATES];
+	const T* rights[N_GATES];
+	int size;
+
+	YaoGateBatch() :
+			size(0)
+	{
+	}
+
+	// returns true if full
+	bool add(T& output, const T& left, const T& right)
+	{
+		outputs[size] = &output;
+		lefts[size] = &left;
+		rights[size] = &right;
+		return ++size == N_GATES;
+	}
+};
+
+#endif /* YAO_YAOGATEBATCH_H_ */
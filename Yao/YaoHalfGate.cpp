@@ -12,11 +12,11 @@ YaoHalfGate::YaoHalfGate(YaoGarbleWire& out, const YaoGarbleWire& left,
 {
 	for (int i = 0; i < 4; i++)
 		assert(function[i] == Function(0x0001)[i]);
-	Key labels[4];
-	Key hashes[4];
+	Key labels[N_GARBLE_HASHES];
+	Key hashes[N_GARBLE_HASHES];
 	E_inputs(labels, left, right, YaoGarbler::s().get_delta().doubling(1),
 			{}, YaoGarbler::s().counter);
-	YaoGarbler::s().mmo.hash<4>(hashes, labels);
+	YaoGarbler::s().mmo.hash<N_GARBLE_HASHES>(hashes, labels);
 	and_garble(out, hashes, left, right, YaoGarbler::s().get_delta());
 }
 
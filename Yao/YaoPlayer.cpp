@@ -8,6 +8,7 @@
 #include "YaoEvaluator.h"
 #include "Tools/ezOptionParser.h"
 #include "Tools/NetworkOptions.h"
+#include "Math/Setup.h"
 
 #include "GC/Machine.hpp"
 
@@ -41,6 +42,24 @@ YaoPlayer::YaoPlayer(int argc, const char** argv)
 	        "-b", // Flag token.
 	        "--batch-size" // Flag token.
 	);
+	opt.add(
+			"1024", // Default.
+			0, // Required?
+			1, // Number of args expected.
+			0, // Delimiter if expecting multiple args.
+			("Megabytes of garbled circuit to keep in memory with -O, "
+					"the rest is stored in " PREP_DIR " (default: 1024)"), // Help description.
+			"--garbled-memory" // Flag token.
+	);
+	opt.add(
+			"0", // Default.
+			0, // Required?
+			1, // Number of args expected.
+			0, // Delimiter if expecting multiple args.
+			("Threads for garbling and evaluation per program thread "
+					"(default: cores divided by program threads)"), // Help description.
+			"--worker-threads" // Flag token.
+	);
 	auto& online_opts = OnlineOptions::singleton;
 	online_opts = {opt, argc, argv, false};
 	NetworkOptionsWithNumber network_opts(opt, argc, argv, 2, false);
@@ -48,16 +67,22 @@ YaoPlayer::YaoPlayer(int argc, const char** argv)
 
 	int my_num = online_opts.playerno;
 	int threshold;
+	long long garbled_memory;
+	int n_worker_threads;
 	bool continuous = not opt.get("-O")->isSet;
 	opt.get("-t")->getInt(threshold);
+	opt.get("--garbled-memory")->getLongLong(garbled_memory);
+	opt.get("--worker-threads")->getInt(n_worker_threads);
 	opt.get("-b")->getInt(online_opts.batch_size);
 	progname = online_opts.progname;
 
 	GC::ThreadMasterBase* master;
 	if (my_num == 0)
-	    master = new YaoGarbleMaster(continuous, online_opts, threshold);
+	    master = new YaoGarbleMaster(continuous, online_opts, threshold,
+	            n_worker_threads);
 	else
-	    master = new YaoEvalMaster(continuous, online_opts);
+	    master = new YaoEvalMaster(continuous, online_opts,
+	            size_t(garbled_memory) << 20, n_worker_threads);
 
 	network_opts.start_networking(master->N, my_num);
 	master->run(progname);
@@ -0,0 +1,67 @@
+/*
+ * YaoSendJob.h
+ *
+ */
+
+#ifndef YAO_YAOSENDJOB_H_
+#define YAO_YAOSENDJOB_H_
+
+#include "Networking/Player.h"
+#include "Tools/FlexBuffer.h"
+#include "Tools/Worker.h"
+
+/**
+ * Sends garbled gates and output masks in the background
+ * while garbling continues,
+ * using a player that the main thread doesn't use at the same time
+ */
+class YaoSendJob
+{
+	Player* P;
+	long status;
+	SendBuffer gates, output_masks;
+	bool busy;
+
+public:
+	Worker<YaoSendJob> worker;
+
+	YaoSendJob() :
+			P(0), status(0), busy(false)
+	{
+	}
+
+	~YaoSendJob()
+	{
+		wait();
+	}
+
+	// takes over the buffers
+	void send(Player& P, long status, SendBuffer& gates,
+			SendBuffer& output_masks)
+	{
+		wait();
+		this->P = &P;
+		this->status = status;
+		this->gates = gates;
+		this->output_masks = output_masks;
+		busy = true;
+		worker.request(*this);
+	}
+
+	void wait()
+	{
+		if (busy)
+			worker.done();
+		busy = false;
+	}
+
+	int run()
+	{
+		P->send_long(1, status);
+		P->send_to(1, gates);
+		P->send_to(1, output_masks);
+		return 0;
+	}
+};
+
+#endif /* YAO_YAOSENDJOB_H_ */
@@ -0,0 +1,32 @@
+/*
+ * YaoThreeHalvesGate.cpp
+ *
+ */
+
+#include "YaoThreeHalvesGate.h"
+#include "YaoGarbler.h"
+#include "YaoEvaluator.h"
+
+YaoThreeHalvesGate::YaoThreeHalvesGate(YaoGarbleWire& out,
+		const YaoGarbleWire& left, const YaoGarbleWire& right,
+		Function function)
+{
+	for (int i = 0; i < 4; i++)
+		assert(function[i] == Function(0x0001)[i]);
+	Key labels[N_GARBLE_HASHES];
+	Key hashes[N_GARBLE_HASHES];
+	E_inputs(labels, left, right, YaoGarbler::s().get_delta().doubling(1),
+			{}, YaoGarbler::s().counter);
+	YaoGarbler::s().mmo.hash<N_GARBLE_HASHES>(hashes, labels);
+	and_garble(out, hashes, left, right, YaoGarbler::s().get_delta());
+}
+
+void YaoThreeHalvesGate::eval(YaoEvalWire& out, const YaoEvalWire& left,
+		const YaoEvalWire& right)
+{
+	Key hashes[N_EVAL_HASHES];
+	Key labels[N_EVAL_HASHES];
+	eval_inputs(labels, left.key(), right.key(), YaoEvaluator::s().counter);
+	YaoEvaluator::s().mmo.hash<N_EVAL_HASHES>(hashes, labels);
+	eval(out, hashes, left, right);
+}
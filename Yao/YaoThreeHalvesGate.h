@@ -0,0 +1,195 @@
+/*
+ * YaoThreeHalvesGate.h
+ *
+ */
+
+#ifndef YAO_YAOTHREEHALVESGATE_H_
+#define YAO_YAOTHREEHALVESGATE_H_
+
+#include "BMR/Key.h"
+#include "YaoGarbleWire.h"
+#include "YaoEvalWire.h"
+
+/**
+ * AND gates with three half-size ciphertexts and six control bits as
+ * described by Rosulek and Roy (https://eprint.iacr.org/2021/749).
+ * The evaluator combines the lower and upper halves of the input labels
+ * depending on the colors and on two dicing bits per combination of colors.
+ * The garbler chooses the dicing bits at random such that
+ * the bits of any single combination reveal nothing about the masks.
+ */
+class __attribute__((packed)) YaoThreeHalvesGate
+{
+	uint64_t G[3];
+	octet control;
+
+	static uint64_t lower(const Key& key)
+	{
+		return key.get<unsigned long>();
+	}
+	static uint64_t upper(const Key& key)
+	{
+		return _mm_cvtsi128_si64(_mm_unpackhi_epi64(key.r, key.r));
+	}
+
+	static uint64_t half(int coeffs, const Key& key);
+	static Key combine(bool i, bool j, int r, const Key& left,
+			const Key& right, const Key& left_hash, const Key& right_hash,
+			const Key& sum_hash);
+	static int key_bits(const Key& left_hash, const Key& right_hash)
+	{
+		return (upper(left_hash) ^ upper(right_hash)) & 3;
+	}
+
+public:
+	static const int N_EVAL_HASHES = 3;
+	static const int N_GARBLE_HASHES = 6;
+
+	static void eval_inputs(Key* output, const Key& left, const Key& right,
+			long T);
+	static void E_inputs(Key* output, const YaoGarbleWire& left,
+			const YaoGarbleWire& right, const Key& left_delta,
+			const Key& right_delta, long T);
+	// the output key only provides randomness for the dicing bits
+	static void randomize(YaoGarbleWire& out, PRNG& prng)
+	{
+		out.randomize(prng);
+	}
+	static Key garble_public_input(bool value, Key delta)
+	{
+		return value ? delta : 0;
+	}
+
+	YaoThreeHalvesGate() {}
+	YaoThreeHalvesGate(YaoGarbleWire&, const YaoGarbleWire&,
+			const YaoGarbleWire&, Function);
+	void and_garble(YaoGarbleWire& out, const Key* hashes,
+			const YaoGarbleWire& left, const YaoGarbleWire& right, Key delta);
+	void eval(YaoEvalWire&, const YaoEvalWire&,
+			const YaoEvalWire&);
+	void eval(YaoEvalWire& out, const Key* hashes, const YaoEvalWire& left,
+			const YaoEvalWire& right);
+};
+
+/**
+ * Sum of the halves of ``key`` selected by ``coeffs``,
+ * bit 1 for the lower half and bit 0 for the upper half
+ */
+inline uint64_t YaoThreeHalvesGate::half(int coeffs, const Key& key)
+{
+	return (-uint64_t((coeffs >> 1) & 1) & lower(key))
+			^ (-uint64_t(coeffs & 1) & upper(key));
+}
+
+/**
+ * Output label of the evaluator without the ciphertexts
+ * for colors ``i`` and ``j`` and dicing bits ``r``
+ */
+inline Key YaoThreeHalvesGate::combine(bool i, bool j, int r,
+		const Key& left, const Key& right, const Key& left_hash,
+		const Key& right_hash, const Key& sum_hash)
+{
+	int left_lower = ((r >> 1) * 3) ^ ((r & 1) * 2) ^ (j * 2);
+	int left_upper = r;
+	int right_lower = r ^ (i << 1 | j);
+	int right_upper = ((r >> 1) * 1) ^ ((r & 1) * 3) ^ (j * 3);
+	uint64_t res_lower = lower(left_hash) ^ lower(sum_hash)
+			^ half(left_lower, left) ^ half(right_lower, right);
+	uint64_t res_upper = lower(right_hash) ^ lower(sum_hash)
+			^ half(left_upper, left) ^ half(right_upper, right);
+	return Key(res_upper, res_lower);
+}
+
+inline void YaoThreeHalvesGate::E_inputs(Key* output,
+		const YaoGarbleWire& left, const YaoGarbleWire& right,
+		const Key& left_delta, const Key&, long T)
+{
+	auto l = left.full_key().doubling(1);
+	auto r = right.full_key().doubling(1);
+	long j = 3 * T;
+	output[0] = l ^ j;
+	output[1] = output[0] ^ left_delta;
+	output[2] = r ^ (j + 1);
+	output[3] = output[2] ^ left_delta;
+	output[4] = l ^ r ^ (j + 2);
+	output[5] = output[4] ^ left_delta;
+}
+
+inline void YaoThreeHalvesGate::and_garble(YaoGarbleWire& out,
+		const Key* hashes, const YaoGarbleWire& left,
+		const YaoGarbleWire& right, Key delta)
+{
+	bool alpha = left.mask();
+	bool beta = right.mask();
+	Key A[2] = {left.full_key(), left.full_key() ^ delta};
+	Key B[2] = {right.full_key(), right.full_key() ^ delta};
+	const Key* x = hashes;
+	const Key* y = hashes + 2;
+	const Key* z = hashes + 4;
+
+	// dicing bits indexed by colors
+	int r[2][2];
+	int random = out.full_key().get<unsigned long>() & 3;
+	int v = alpha << 1 | beta;
+	int w = (alpha * 1) ^ (beta * 3);
+	r[0][0] = random;
+	r[1][0] = random ^ w;
+	r[0][1] = random ^ 1 ^ v ^ w;
+	r[1][1] = random ^ 1 ^ v;
+
+	// solve the evaluator's equations for colors (0,0), (1,1), and (1,0)
+	Key C0 = combine(0, 0, r[0][0], A[alpha], B[beta], x[alpha], y[beta],
+			z[alpha ^ beta]);
+	if (alpha and beta)
+		C0 ^= delta;
+	Key T = combine(1, 1, r[1][1], A[!alpha], B[!beta], x[!alpha],
+			y[!beta], z[alpha ^ beta]) ^ C0;
+	if (!alpha and !beta)
+		T ^= delta;
+	G[0] = lower(T);
+	G[1] = upper(T);
+	T = combine(1, 0, r[1][0], A[!alpha], B[beta], x[!alpha], y[beta],
+			z[!alpha ^ beta]) ^ C0;
+	if (!alpha and beta)
+		T ^= delta;
+	G[2] = lower(T) ^ G[0];
+
+	int c[2][2];
+	for (int i = 0; i < 2; i++)
+		for (int j = 0; j < 2; j++)
+			c[i][j] = r[i][j] ^ key_bits(x[i ^ alpha], y[j ^ beta]);
+	assert((c[0][0] ^ c[0][1] ^ c[1][0] ^ c[1][1]) == 0);
+	control = c[0][0] | c[0][1] << 2 | c[1][0] << 4;
+
+	out.set_full_key(C0);
+}
+
+inline void YaoThreeHalvesGate::eval_inputs(Key* output, const Key& left,
+		const Key& right, long T)
+{
+	long j = 3 * T;
+	auto l = left.doubling(1);
+	auto r = right.doubling(1);
+	output[0] = l ^ j;
+	output[1] = r ^ (j + 1);
+	output[2] = l ^ r ^ (j + 2);
+}
+
+inline void YaoThreeHalvesGate::eval(YaoEvalWire& out, const Key* hashes,
+		const YaoEvalWire& left, const YaoEvalWire& right)
+{
+	bool i = left.external();
+	bool j = right.external();
+	int c = control >> (4 * i + 2 * j);
+	if (i and j)
+		c ^= control ^ (control >> 2) ^ (control >> 4);
+	int r = (c ^ key_bits(hashes[0], hashes[1])) & 3;
+	Key res = combine(i, j, r, left.key(), right.key(), hashes[0],
+			hashes[1], hashes[2]);
+	uint64_t mask_i = -uint64_t(i), mask_j = -uint64_t(j);
+	res ^= Key(mask_j & G[1], mask_i & G[0]);
+	res ^= Key(-uint64_t(i ^ j) & G[2], -uint64_t(i ^ j) & G[2]);
+	out.set(res);
+}
+
+#endif /* YAO_YAOTHREEHALVESGATE_H_ */